@@ -205,7 +205,12 @@ impl Default for PagingSpec {
 }
 
 impl PagingSpec {
-  pub(crate) fn n_per_page(&self, n: usize) -> PcoResult<Vec<usize>> {
+  /// Returns the count of numbers to put in each page if a chunk of `n`
+  /// numbers is split according to this spec.
+  ///
+  /// Will return an invalid argument error if the spec is incompatible
+  /// with `n`.
+  pub fn n_per_page(&self, n: usize) -> PcoResult<Vec<usize>> {
     let n_per_page = match self {
       // You might think it would be beneficial to do either of these:
       // * greedily fill pages since compressed chunk size seems like a concave
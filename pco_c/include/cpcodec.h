@@ -1,3 +1,6 @@
+#include <stddef.h>
+#include <stdint.h>
+
 #if defined (__cplusplus)
 extern "C" {
 #endif
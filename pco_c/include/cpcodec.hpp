@@ -0,0 +1,174 @@
+// Header-only C++17 wrapper around the C API in cpcodec.h.
+//
+// Adds RAII ownership of FFI vectors, exceptions carrying the message from
+// pco_last_error_message, and a compile-time mapping from element type to
+// dtype byte, so call sites need neither hand-rolled guards nor dtype
+// tables. When compiled as C++20 or later, std::span overloads are
+// available as well.
+
+#ifndef CPCODEC_HPP
+#define CPCODEC_HPP
+
+#include "cpcodec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+
+namespace pco {
+
+// Maps an element type to its dtype byte at compile time; unsupported types
+// fail to instantiate.
+template <typename T>
+struct dtype_of;
+
+#define CPCODEC_HPP_DTYPE(T, BYTE)               \
+  template <>                                    \
+  struct dtype_of<T> {                           \
+    static constexpr unsigned char value = BYTE; \
+  };
+
+CPCODEC_HPP_DTYPE(std::uint32_t, PCO_TYPE_U32)
+CPCODEC_HPP_DTYPE(std::uint64_t, PCO_TYPE_U64)
+CPCODEC_HPP_DTYPE(std::int32_t, PCO_TYPE_I32)
+CPCODEC_HPP_DTYPE(std::int64_t, PCO_TYPE_I64)
+CPCODEC_HPP_DTYPE(float, PCO_TYPE_F32)
+CPCODEC_HPP_DTYPE(double, PCO_TYPE_F64)
+CPCODEC_HPP_DTYPE(std::uint16_t, PCO_TYPE_U16)
+CPCODEC_HPP_DTYPE(std::int16_t, PCO_TYPE_I16)
+#undef CPCODEC_HPP_DTYPE
+
+template <typename T>
+inline constexpr unsigned char dtype_of_v = dtype_of<T>::value;
+
+// Thrown by the wrappers below when the underlying call does not return
+// PcoSuccess; what() carries the thread's last error message.
+class error : public std::runtime_error {
+ public:
+  explicit error(PcoError code) : std::runtime_error(last_message()), code_(code) {}
+
+  PcoError code() const noexcept { return code_; }
+
+ private:
+  static std::string last_message() {
+    char buf[512];
+    if (pco_last_error_message(buf, sizeof(buf)) != PcoSuccess || buf[0] == '\0') {
+      return "unknown pco error";
+    }
+    return buf;
+  }
+
+  PcoError code_;
+};
+
+inline void check(PcoError code) {
+  if (code != PcoSuccess) {
+    throw error(code);
+  }
+}
+
+// RAII ownership of a PcoFfiVec of `T` elements: frees the FFI-owned buffer
+// on destruction, and is movable but not copyable.
+template <typename T>
+class vec {
+ public:
+  vec() noexcept : v_{nullptr, 0, nullptr} {}
+  vec(const vec&) = delete;
+  vec& operator=(const vec&) = delete;
+  vec(vec&& other) noexcept : v_(other.v_) { other.release(); }
+  vec& operator=(vec&& other) noexcept {
+    if (this != &other) {
+      reset();
+      v_ = other.v_;
+      other.release();
+    }
+    return *this;
+  }
+  ~vec() { reset(); }
+
+  const T* data() const noexcept { return static_cast<const T*>(v_.ptr); }
+  std::size_t size() const noexcept { return v_.len; }
+  bool empty() const noexcept { return v_.len == 0; }
+  const T* begin() const noexcept { return data(); }
+  const T* end() const noexcept { return data() + size(); }
+  const T& operator[](std::size_t i) const noexcept { return data()[i]; }
+#if defined(__cpp_lib_span)
+  std::span<const T> span() const noexcept { return {data(), size()}; }
+#endif
+
+  // For C calls that fill a PcoFfiVec out-param; any held buffer is freed
+  // first.
+  PcoFfiVec* out() noexcept {
+    reset();
+    return &v_;
+  }
+
+ private:
+  void reset() noexcept {
+    if (v_.raw_box != nullptr) {
+      pco_free_pcovec(&v_);
+    }
+    release();
+  }
+  void release() noexcept { v_ = PcoFfiVec{nullptr, 0, nullptr}; }
+
+  PcoFfiVec v_;
+};
+
+using bytes = vec<unsigned char>;
+
+inline PcoChunkConfig default_chunk_config() {
+  PcoChunkConfig config;
+  check(pco_default_chunk_config(&config));
+  return config;
+}
+
+template <typename T>
+bytes simpler_compress(const T* nums, std::size_t len, unsigned int level) {
+  bytes out;
+  check(pco_simpler_compress(
+    nums, static_cast<unsigned int>(len), dtype_of_v<T>, level, out.out()));
+  return out;
+}
+
+template <typename T>
+bytes simple_compress(const T* nums, std::size_t len, const PcoChunkConfig& config) {
+  bytes out;
+  check(pco_simple_compress(
+    nums, static_cast<unsigned int>(len), dtype_of_v<T>, &config, out.out()));
+  return out;
+}
+
+template <typename T>
+vec<T> simple_decompress(const void* compressed, std::size_t len) {
+  vec<T> out;
+  check(pco_simple_decompress(
+    compressed, static_cast<unsigned int>(len), dtype_of_v<T>, out.out()));
+  return out;
+}
+
+#if defined(__cpp_lib_span)
+template <typename T>
+bytes simpler_compress(std::span<const T> nums, unsigned int level) {
+  return simpler_compress(nums.data(), nums.size(), level);
+}
+
+template <typename T>
+bytes simple_compress(std::span<const T> nums, const PcoChunkConfig& config) {
+  return simple_compress(nums.data(), nums.size(), config);
+}
+
+template <typename T>
+vec<T> simple_decompress(std::span<const unsigned char> compressed) {
+  return simple_decompress<T>(compressed.data(), compressed.size());
+}
+#endif
+
+}  // namespace pco
+
+#endif  // CPCODEC_HPP
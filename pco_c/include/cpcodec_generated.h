@@ -1,25 +1,831 @@
 typedef enum PcoError {
   PcoSuccess,
   PcoInvalidType,
+  /**
+   * Generic compression failure; retained for ABI compatibility. Newer
+   * entry points report one of the specific kinds below instead.
+   */
   PcoCompressionError,
+  /**
+   * Generic decompression failure; retained for ABI compatibility. Newer
+   * entry points report one of the specific kinds below instead.
+   */
   PcoDecompressionError,
+  /**
+   * Decompression reached the end of the provided bytes before finishing;
+   * the caller should retry with more data.
+   */
+  PcoInsufficientDataError,
+  /**
+   * The compressed data requires a newer version of pco to decode.
+   */
+  PcoCompatibilityError,
+  /**
+   * The compressed data is inconsistent or violates the pco format.
+   */
+  PcoCorruptionError,
+  /**
+   * The arguments provided were invalid, e.g. a bad config or a too-small
+   * destination buffer.
+   */
+  PcoInvalidArgumentError,
+  PcoIoError,
+  /**
+   * The operation was abandoned at a batch boundary because the handle's
+   * deadline passed or its cancel callback fired.
+   */
+  PcoCancelledError,
 } PcoError;
 
+/**
+ * Mirrors the `Disabled`/`Enabled`/`Provided` shape shared by
+ * `IntMultSpec`, `FloatMultSpec`, and `FloatQuantSpec`.
+ * When `Provided` is used, the accompanying value field in `PcoChunkConfig`
+ * supplies the base (or bit count, for float quantization).
+ */
+typedef enum PcoSpec {
+  PcoSpecDisabled,
+  PcoSpecEnabled,
+  PcoSpecProvided,
+} PcoSpec;
+
+/**
+ * Mirrors the discriminant of `pco::Mode`.
+ */
+typedef enum PcoMode {
+  PcoModeClassic,
+  PcoModeIntMult,
+  PcoModeFloatMult,
+  PcoModeFloatQuant,
+} PcoMode;
+
+/**
+ * Opaque handle for incremental, push-style standalone compression.
+ *
+ * Numbers pushed in are buffered until a full chunk (per the config's
+ * paging spec) accumulates, at which point it is compressed; finished bytes
+ * can be pulled out at any time, so compression can overlap with ingestion
+ * without the caller materializing the whole column first.
+ */
+typedef struct PcoCompressor PcoCompressor;
+
+/**
+ * Opaque handle holding compression settings trained once on a sample, for
+ * compressing many similar small arrays.
+ *
+ * Training compresses the sample once and pins the detected mode (with its
+ * base), delta encoding order, and paging, so later calls skip the
+ * per-array detection passes that dominate at 1k-10k element sizes. Each
+ * compressed array is still a self-contained standalone file carrying its
+ * own bins and ANS tables, since the pco format requires every chunk's
+ * tables to be derived from its own data for decodability.
+ */
+typedef struct PcoContext PcoContext;
+
+/**
+ * Opaque handle wrapping `pco::standalone::FileDecompressor`.
+ *
+ * Unlike `pco_simple_decompress`, this allows decoding a standalone file one
+ * chunk at a time, so disk reads can be overlapped with decompression and
+ * only one chunk's worth of compressed bytes needs to be resident.
+ */
+typedef struct PcoDecompressor PcoDecompressor;
+
+/**
+ * Opaque handle to a memory-mapped standalone file (POSIX only).
+ *
+ * Opening parses only the header and the first chunk's data type byte;
+ * pages are decoded on demand through the range and streaming entry points
+ * over the mapped bytes, so the file is never copied into RAM wholesale and
+ * the OS page cache serves repeated partial scans.
+ */
+typedef struct PcoMapped PcoMapped;
+
+/**
+ * Opaque handle wrapping `pco::wrapped::ChunkCompressor`.
+ */
+typedef struct PcoWrappedCc PcoWrappedCc;
+
+/**
+ * Opaque handle wrapping `pco::wrapped::ChunkDecompressor`.
+ */
+typedef struct PcoWrappedCd PcoWrappedCd;
+
+/**
+ * Opaque handle wrapping `pco::wrapped::FileCompressor`.
+ */
+typedef struct PcoWrappedFc PcoWrappedFc;
+
+/**
+ * Opaque handle wrapping `pco::wrapped::FileDecompressor`.
+ */
+typedef struct PcoWrappedFd PcoWrappedFd;
+
+/**
+ * Allocates `size` bytes with alignment `align`, returning null on failure.
+ */
+typedef void *(*PcoAllocFn)(void *user_data, size_t size, size_t align);
+
+/**
+ * Frees a pointer previously returned by the paired `PcoAllocFn` with the
+ * same size and alignment.
+ */
+typedef void (*PcoFreeFn)(void *user_data, void *ptr, size_t size, size_t align);
+
+/**
+ * Mirrors `pco::ChunkConfig`; see that struct for the meaning of each
+ * configuration.
+ *
+ * Use `pco_default_chunk_config` to fill one of these with default values
+ * before overriding the fields you care about.
+ */
+typedef struct PcoChunkConfig {
+  unsigned int compression_level;
+  /**
+   * 0 through 7, or -1 to automatically detect the delta encoding order on
+   * each chunk.
+   */
+  int delta_encoding_order;
+  enum PcoSpec int_mult_spec;
+  uint64_t int_mult_base;
+  enum PcoSpec float_mult_spec;
+  double float_mult_base;
+  enum PcoSpec float_quant_spec;
+  unsigned int float_quant_bits;
+  /**
+   * If `exact_page_ns` is null, chunks are split into equal pages of up to
+   * `max_page_n` numbers; otherwise pages get exactly the provided counts.
+   */
+  unsigned int max_page_n;
+  const unsigned int *exact_page_ns;
+  unsigned int n_exact_pages;
+  /**
+   * If nonzero, `pco_simple_compress` appends a seek index after the
+   * standalone terminator byte: per-chunk byte offsets and cumulative
+   * number counts, costing 8 bytes per chunk. pco readers stop at the
+   * terminator, so indexed files stay decodable everywhere, but
+   * `pco_decompress_range` and `pco_parse_seek_index` use the index to
+   * jump straight to a chunk instead of decoding everything before it.
+   */
+  unsigned char enable_seek_index;
+} PcoChunkConfig;
+
 typedef struct PcoFfiVec {
   const void *ptr;
   unsigned int len;
   const void *raw_box;
 } PcoFfiVec;
 
+/**
+ * Like `PcoFfiVec`, but with a `size_t` length for columns of 2^32 or more
+ * numbers.
+ */
+typedef struct PcoFfiVec64 {
+  const void *ptr;
+  size_t len;
+  const void *raw_box;
+} PcoFfiVec64;
+
+typedef struct PcoProgress {
+  unsigned int n_processed;
+  unsigned char finished;
+} PcoProgress;
+
+/**
+ * Like `PcoProgress`, but with a `size_t` count for columns of 2^32 or more
+ * numbers.
+ */
+typedef struct PcoProgress64 {
+  size_t n_processed;
+  unsigned char finished;
+} PcoProgress64;
+
+/**
+ * CPU capability report for confirming which code paths a deployed artifact
+ * can take; each flag is 0 or 1.
+ *
+ * The `detected_` flags reflect the machine at runtime; the `compiled_`
+ * flags reflect the target features the artifact was built to assume
+ * unconditionally. A feature that is detected but not compiled in is still
+ * used by the runtime-dispatched kernels, which carry their own per-feature
+ * code paths.
+ */
+typedef struct PcoCpuFeatures {
+  unsigned char detected_avx2;
+  unsigned char detected_avx512f;
+  unsigned char detected_neon;
+  unsigned char compiled_avx2;
+  unsigned char compiled_avx512f;
+  unsigned char compiled_neon;
+} PcoCpuFeatures;
+
+/**
+ * Header-level facts about a standalone file, readable without decoding
+ * any chunk.
+ */
+typedef struct PcoFileStats {
+  /**
+   * The count of numbers in the file as recorded in its header.
+   * Files written by pco record this exactly; files written by other
+   * implementations or old standalone versions may record 0 instead.
+   */
+  unsigned int n_hint;
+  unsigned char format_version;
+  /**
+   * The data type byte of the first chunk, or 0 if the file has no chunks.
+   */
+  unsigned char first_dtype_byte;
+  /**
+   * The count of header bytes before the first chunk.
+   */
+  unsigned int header_size;
+} PcoFileStats;
+
+typedef struct PcoLatentVarStats {
+  unsigned int n_bins;
+  unsigned int ans_size_log;
+} PcoLatentVarStats;
+
+/**
+ * Metadata about a chunk, mirroring what `pco_cli inspect` reports,
+ * readable without decoding any page.
+ */
+typedef struct PcoChunkStats {
+  /**
+   * The count of numbers in the chunk.
+   */
+  unsigned int n;
+  enum PcoMode mode;
+  /**
+   * The value accompanying the mode: the base as raw latent bits for
+   * `IntMult`/`FloatMult`, the bit count for `FloatQuant`, and 0 for
+   * `Classic`.
+   */
+  uint64_t mode_value;
+  unsigned int delta_encoding_order;
+  /**
+   * Either 1 or 2; `Classic` mode has a single latent variable and the
+   * other modes add an adjustment variable.
+   */
+  unsigned int n_latent_vars;
+  struct PcoLatentVarStats latent_vars[2];
+} PcoChunkStats;
+
+/**
+ * One seek index entry; `byte_offset` can be fed directly to
+ * `pco_decompress_chunks_parallel` as a chunk offset.
+ */
+typedef struct PcoSeekEntry {
+  unsigned int byte_offset;
+  unsigned int cum_n;
+} PcoSeekEntry;
+
+/**
+ * Per-handle performance counters, separating chunk metadata work from page
+ * coding so slow scans can be attributed by phase. The cost is two clock
+ * reads per chunk, cheap enough to leave on in production.
+ */
+typedef struct PcoStats {
+  /**
+   * Nanoseconds spent on chunk metadata: mode and delta detection, bin
+   * optimization, and ANS table setup.
+   */
+  uint64_t meta_nanos;
+  /**
+   * Nanoseconds spent encoding or decoding pages.
+   */
+  uint64_t page_nanos;
+  /**
+   * The count of numbers pushed through the handle.
+   */
+  uint64_t n_processed;
+  /**
+   * The count of compressed bytes produced or consumed.
+   */
+  uint64_t n_bytes;
+} PcoStats;
+
+/**
+ * One column of a batch compression call.
+ */
+typedef struct PcoArray {
+  const void *nums;
+  unsigned int len;
+  unsigned char dtype;
+} PcoArray;
+
+/**
+ * Returns nonzero if the operation should be cancelled; polled at batch
+ * boundaries during decompression.
+ */
+typedef unsigned char (*PcoCancelFn)(void *user_data);
+
+/**
+ * Makes all future allocations go through `alloc_fn`/`free_fn`, e.g. to pin
+ * decompressed columns to a particular NUMA node's arena.
+ *
+ * Must be called before any other pco function so no buffer allocated by the
+ * previous allocator gets freed by the new one; for the same reason it may
+ * only be called once. Passing null for both functions is an error rather
+ * than a reset.
+ */
+enum PcoError pco_set_allocator(PcoAllocFn alloc_fn, PcoFreeFn free_fn, void *user_data);
+
+/**
+ * Reports the library-wide count of heap allocations and allocated bytes
+ * since load. The counters are monotonic and never reset, so subtracting
+ * successive readings attributes allocations to the calls in between. The
+ * binding layer performs no per-chunk allocations on the streaming decode
+ * path; the difference across a steady-state scan therefore measures the
+ * core's per-chunk scratch, and a growing per-call delta indicates a
+ * regression in the allocation profile.
+ */
+enum PcoError pco_alloc_stats(uint64_t *n_allocs, uint64_t *n_bytes);
+
+/**
+ * Copies the message of the most recent error on this thread into `dst` as a
+ * NUL-terminated string, truncating to `dst_capacity` bytes (including the
+ * NUL) if necessary.
+ */
+enum PcoError pco_last_error_message(char *dst, size_t dst_capacity);
+
+enum PcoError pco_default_chunk_config(struct PcoChunkConfig *dst);
+
 enum PcoError pco_simpler_compress(const void *nums,
                                    unsigned int len,
                                    unsigned char dtype,
                                    unsigned int level,
                                    struct PcoFfiVec *dst);
 
+enum PcoError pco_simpler_compress64(const void *nums,
+                                     size_t len,
+                                     unsigned char dtype,
+                                     unsigned int level,
+                                     struct PcoFfiVec64 *dst);
+
+enum PcoError pco_simple_compress(const void *nums,
+                                  unsigned int len,
+                                  unsigned char dtype,
+                                  const struct PcoChunkConfig *config,
+                                  struct PcoFfiVec *dst);
+
+enum PcoError pco_simple_compress64(const void *nums,
+                                    size_t len,
+                                    unsigned char dtype,
+                                    const struct PcoChunkConfig *config,
+                                    struct PcoFfiVec64 *dst);
+
 enum PcoError pco_simple_decompress(const void *compressed,
                                     unsigned int len,
                                     unsigned char dtype,
                                     struct PcoFfiVec *dst);
 
+enum PcoError pco_simple_decompress64(const void *compressed,
+                                      size_t len,
+                                      unsigned char dtype,
+                                      struct PcoFfiVec64 *dst);
+
+enum PcoError pco_simple_decompress_into(const void *compressed,
+                                         unsigned int len,
+                                         unsigned char dtype,
+                                         void *dst,
+                                         unsigned int dst_len,
+                                         struct PcoProgress *progress);
+
+enum PcoError pco_simple_decompress_into64(const void *compressed,
+                                           size_t len,
+                                           unsigned char dtype,
+                                           void *dst,
+                                           size_t dst_len,
+                                           struct PcoProgress64 *progress);
+
+enum PcoError pco_free_pcovec64(struct PcoFfiVec64 *ffi_vec);
+
 enum PcoError pco_free_pcovec(struct PcoFfiVec *ffi_vec);
+
+/**
+ * Trains a `PcoContext` on a representative sample. A null `config` uses
+ * the default chunk config as the starting point; its specs are overridden
+ * by whatever mode and delta order the sample exhibits.
+ */
+enum PcoError pco_context_new(const void *sample,
+                              unsigned int sample_len,
+                              unsigned char dtype,
+                              const struct PcoChunkConfig *config,
+                              struct PcoContext **dst);
+
+/**
+ * Runs mode and delta order detection on a sample and writes the resulting
+ * concrete config to `dst`. Unlike a `PcoContext`, the result is a plain
+ * struct the caller can persist (e.g. in a catalog) and replay later through
+ * `pco_simple_compress` or any other config-taking entry point, converting
+ * per-chunk detection into a once-per-column cost. A null `config` starts
+ * from the default chunk config; paging and seek index settings pass through
+ * unchanged since detection only concerns mode and delta order. The output's
+ * `exact_page_ns` aliases the input's, so it stays valid only as long as
+ * that buffer does.
+ */
+enum PcoError pco_detect_config(const void *sample,
+                                unsigned int sample_len,
+                                unsigned char dtype,
+                                const struct PcoChunkConfig *config,
+                                struct PcoChunkConfig *dst);
+
+/**
+ * Compresses one array with the context's trained settings, skipping mode
+ * and delta order detection.
+ */
+enum PcoError pco_context_compress(const struct PcoContext *context,
+                                   const void *nums,
+                                   unsigned int len,
+                                   struct PcoFfiVec *dst);
+
+enum PcoError pco_context_free(struct PcoContext *context);
+
+/**
+ * Memory-maps the standalone file at `path` (a NUL-terminated UTF-8 path)
+ * read-only and parses its header.
+ */
+enum PcoError pco_open_mapped(const char *path, struct PcoMapped **dst);
+
+/**
+ * Exposes the mapped bytes so any decompression entry point can run over
+ * them zero-copy. The pointer stays valid until `pco_close_mapped`.
+ */
+enum PcoError pco_mapped_bytes(const struct PcoMapped *mapped, const void **ptr, size_t *len);
+
+enum PcoError pco_mapped_n_hint(const struct PcoMapped *mapped, unsigned int *dst);
+
+/**
+ * The data type byte of the file's first chunk, or 0 if it has no chunks,
+ * so callers need not know the dtype out of band.
+ */
+enum PcoError pco_mapped_dtype(const struct PcoMapped *mapped, unsigned char *dst);
+
+/**
+ * Decodes only the numbers in `[start_idx, end_idx)`, faulting in just the
+ * mapped pages the decode touches.
+ */
+enum PcoError pco_mapped_decompress_range(const struct PcoMapped *mapped,
+                                          unsigned char dtype,
+                                          unsigned int start_idx,
+                                          unsigned int end_idx,
+                                          void *dst,
+                                          unsigned int *n);
+
+enum PcoError pco_close_mapped(struct PcoMapped *mapped);
+
+/**
+ * Fills `dst` with the CPU features detected at runtime and the target
+ * features this artifact was compiled with.
+ */
+enum PcoError pco_cpu_features(struct PcoCpuFeatures *dst);
+
+enum PcoError pco_file_stats(const void *compressed, unsigned int len, struct PcoFileStats *dst);
+
+enum PcoError pco_peek_num_count(const void *compressed, unsigned int len, unsigned int *dst);
+
+/**
+ * Reports metadata of the first chunk; for multi-chunk files, walk the file
+ * with a `PcoDecompressor` to reach later chunks, since the standalone
+ * format stores no chunk byte sizes to skip by.
+ */
+enum PcoError pco_inspect(const void *compressed,
+                          unsigned int len,
+                          unsigned char dtype,
+                          struct PcoChunkStats *dst);
+
+/**
+ * Reads the seek index appended by compressing with `enable_seek_index`
+ * set. If `dst` is null, only the entry count is written to `n_entries`;
+ * otherwise up to `dst_capacity` entries are copied out as well. Errors
+ * with `PcoInvalidArgumentError` if the file carries no index.
+ */
+enum PcoError pco_parse_seek_index(const void *compressed,
+                                   unsigned int len,
+                                   struct PcoSeekEntry *dst,
+                                   size_t dst_capacity,
+                                   size_t *n_entries);
+
+enum PcoError pco_decompress_range(const void *compressed,
+                                   unsigned int len,
+                                   unsigned char dtype,
+                                   unsigned int start_idx,
+                                   unsigned int end_idx,
+                                   void *dst,
+                                   unsigned int *n);
+
+/**
+ * Decodes the single number at position `idx` into `dst`.
+ *
+ * Cost is proportional to the distance from the start of the owning chunk to
+ * `idx`, since the chunk's streams are entropy coded and must be decoded
+ * sequentially; decoding stops at the batch containing `idx` and nothing
+ * after it is touched. Files written with `enable_seek_index` jump straight
+ * to the owning chunk, so point lookups stay bounded by one chunk's size
+ * instead of the whole file's.
+ */
+enum PcoError pco_get_nth(const void *compressed,
+                          unsigned int len,
+                          unsigned char dtype,
+                          unsigned int idx,
+                          void *dst);
+
+/**
+ * Decompresses a file of `src_dtype` numbers into a buffer of the narrower
+ * `dst_dtype`, converting batch-wise during write-out instead of
+ * materializing a full buffer of the wide type first, roughly halving the
+ * memory traffic of a decompress-then-convert pass.
+ *
+ * Supported pairs: f64 to f32, i64 to i32, and u64 to u32. Float narrowing
+ * rounds to the nearest f32; integer narrowing truncates, so callers should
+ * only use it on columns whose values are known to fit.
+ * The conversion runs through runtime-dispatched kernels, so one artifact
+ * uses AVX-512 or AVX2 where the machine supports it (see
+ * `pco_cpu_features`).
+ */
+enum PcoError pco_decompress_cast(const void *compressed,
+                                  unsigned int len,
+                                  unsigned char src_dtype,
+                                  unsigned char dst_dtype,
+                                  void *dst,
+                                  unsigned int dst_capacity,
+                                  unsigned int *n);
+
+/**
+ * Writes a worst-case bound on the compressed byte size of `len` numbers to
+ * `dst`, so output buffers for `pco_simple_compress_into` can be sized up
+ * front. A null `config` uses the default chunk config.
+ */
+enum PcoError pco_max_compressed_size(unsigned int len,
+                                      unsigned char dtype,
+                                      const struct PcoChunkConfig *config,
+                                      size_t *dst);
+
+/**
+ * Like `pco_simple_compress`, but writes into a caller-provided buffer of
+ * `dst_capacity` bytes (see `pco_max_compressed_size`) instead of an
+ * FFI-owned vector, and reports the compressed byte count in
+ * `n_bytes_written`.
+ */
+enum PcoError pco_simple_compress_into(const void *nums,
+                                       unsigned int len,
+                                       unsigned char dtype,
+                                       const struct PcoChunkConfig *config,
+                                       void *dst,
+                                       size_t dst_capacity,
+                                       size_t *n_bytes_written);
+
+enum PcoError pco_compressor_new(unsigned char dtype,
+                                 const struct PcoChunkConfig *config,
+                                 struct PcoCompressor **dst);
+
+enum PcoError pco_compressor_push(struct PcoCompressor *compressor,
+                                  const void *nums,
+                                  unsigned int len);
+
+enum PcoError pco_compressor_pull(struct PcoCompressor *compressor, struct PcoFfiVec *dst);
+
+enum PcoError pco_compressor_finish(struct PcoCompressor *compressor, struct PcoFfiVec *dst);
+
+/**
+ * Copies the handle's accumulated performance counters to `dst`. For a
+ * compressor, metadata time covers mode/delta detection and bin
+ * optimization per chunk and page time covers chunk serialization.
+ */
+enum PcoError pco_compressor_stats(const struct PcoCompressor *compressor, struct PcoStats *dst);
+
+enum PcoError pco_compressor_free(struct PcoCompressor *compressor);
+
+enum PcoError pco_compress_parallel(const void *nums,
+                                    unsigned int len,
+                                    unsigned char dtype,
+                                    const struct PcoChunkConfig *config,
+                                    unsigned int n_threads,
+                                    struct PcoFfiVec *dst);
+
+/**
+ * Compresses `n_arrays` columns in one FFI crossing, writing one standalone
+ * file per column into `dsts`. The columns may have different data types.
+ * Work fans out over `n_threads` threads (0 means all available cores); a
+ * null `config` uses the default chunk config. On error, no `dsts` entries
+ * are initialized.
+ */
+enum PcoError pco_compress_batch(const struct PcoArray *arrays,
+                                 size_t n_arrays,
+                                 const struct PcoChunkConfig *config,
+                                 unsigned int n_threads,
+                                 struct PcoFfiVec *dsts);
+
+enum PcoError pco_decompress_chunks_parallel(const void *compressed,
+                                             unsigned int len,
+                                             unsigned char dtype,
+                                             const unsigned int *chunk_offsets,
+                                             unsigned int n_chunks,
+                                             unsigned int n_threads,
+                                             void *dst,
+                                             unsigned int dst_capacity,
+                                             unsigned int *n);
+
+enum PcoError pco_decompressor_new(const void *header_src,
+                                   unsigned int len,
+                                   unsigned char dtype,
+                                   struct PcoDecompressor **dst,
+                                   unsigned int *n_bytes_read);
+
+enum PcoError pco_decompressor_n_hint(const struct PcoDecompressor *decompressor,
+                                      unsigned int *dst);
+
+enum PcoError pco_decompressor_peek_chunk_n(const struct PcoDecompressor *decompressor,
+                                            const void *src,
+                                            unsigned int len,
+                                            unsigned int *dst);
+
+enum PcoError pco_decompressor_decompress_chunk(const struct PcoDecompressor *decompressor,
+                                                const void *src,
+                                                unsigned int len,
+                                                void *dst,
+                                                unsigned int dst_capacity,
+                                                unsigned int *n,
+                                                unsigned int *n_bytes_read);
+
+/**
+ * Starts decoding the next chunk on a worker thread and returns immediately,
+ * so the caller can process the previous chunk while this one decodes — a
+ * 2-deep pipeline that hides decode latency behind the consumer's work.
+ *
+ * `src` and `dst` must stay valid and untouched until
+ * `pco_decompressor_await_chunk` returns, and the handle must not be used
+ * for anything else in between; at most one decode may be in flight per
+ * handle. The worker does not poll the handle's deadline or cancel callback.
+ */
+enum PcoError pco_decompressor_decompress_chunk_async(const struct PcoDecompressor *decompressor,
+                                                      const void *src,
+                                                      unsigned int len,
+                                                      void *dst,
+                                                      unsigned int dst_capacity);
+
+/**
+ * Blocks until the decode started by `pco_decompressor_decompress_chunk_async`
+ * finishes, then reports its chunk count and bytes read exactly as the
+ * synchronous call would have.
+ */
+enum PcoError pco_decompressor_await_chunk(const struct PcoDecompressor *decompressor,
+                                           unsigned int *n,
+                                           unsigned int *n_bytes_read);
+
+/**
+ * Gives the handle `deadline_nanos` nanoseconds from now; decompress calls
+ * past the deadline fail with `PcoCancelledError` at the next batch
+ * boundary, reclaiming the CPU for live queries. Passing 0 clears the
+ * deadline.
+ */
+enum PcoError pco_decompressor_set_deadline(const struct PcoDecompressor *decompressor,
+                                            uint64_t deadline_nanos);
+
+/**
+ * Registers a callback polled at batch boundaries during decompression; a
+ * nonzero return fails the call with `PcoCancelledError`. Passing null
+ * clears the callback.
+ */
+enum PcoError pco_decompressor_set_cancel(const struct PcoDecompressor *decompressor,
+                                          PcoCancelFn cancel_fn,
+                                          void *user_data);
+
+/**
+ * Copies the handle's accumulated performance counters to `dst`. For a
+ * decompressor, metadata time covers chunk meta parsing and ANS table
+ * setup and page time covers page decoding.
+ */
+enum PcoError pco_decompressor_stats(const struct PcoDecompressor *decompressor,
+                                     struct PcoStats *dst);
+
+enum PcoError pco_decompressor_free(struct PcoDecompressor *decompressor);
+
+/**
+ * Compresses `n_columns` equal-length columns into one container whose
+ * chunks are interleaved row-group style: each row group holds one chunk per
+ * column, in column order, so reading a row range touches one contiguous
+ * byte range instead of one file per column. Row group boundaries follow the
+ * config's paging spec, the same way `pco_simple_compress` splits chunks.
+ *
+ * The body is a plain standalone file (every chunk carries its own dtype
+ * byte) followed by a footer after the terminator recording the column
+ * count, row count, and per-column dtypes; standalone readers that walk
+ * chunks ignore the footer.
+ */
+enum PcoError pco_multi_compress(const struct PcoArray *columns,
+                                 size_t n_columns,
+                                 const struct PcoChunkConfig *config,
+                                 struct PcoFfiVec *dst);
+
+/**
+ * Reads a column group file's column count, row count, and per-column dtype
+ * bytes without decoding anything. A null `dtypes` skips the dtype copy, so
+ * a first call can learn the column count and a second can fetch the dtypes.
+ */
+enum PcoError pco_multi_inspect(const void *compressed,
+                                unsigned int len,
+                                unsigned char *dtypes,
+                                size_t dtypes_capacity,
+                                size_t *n_columns,
+                                unsigned int *n_rows);
+
+/**
+ * Decompresses every column of a `pco_multi_compress` file in one sequential
+ * pass, writing column `c` into `dsts[c]` (each with room for the file's row
+ * count, reported in `n_rows` even on capacity errors). `n_columns` must
+ * match the file's column count.
+ */
+enum PcoError pco_multi_decompress(const void *compressed,
+                                   unsigned int len,
+                                   void *const *dsts,
+                                   size_t n_columns,
+                                   unsigned int dst_capacity,
+                                   unsigned int *n_rows);
+
+enum PcoError pco_wrapped_file_compressor_new(struct PcoWrappedFc **dst);
+
+enum PcoError pco_wrapped_file_compressor_write_header(const struct PcoWrappedFc *fc,
+                                                       struct PcoFfiVec *dst);
+
+enum PcoError pco_wrapped_file_compressor_chunk_compressor(const struct PcoWrappedFc *fc,
+                                                           const void *nums,
+                                                           unsigned int len,
+                                                           unsigned char dtype,
+                                                           const struct PcoChunkConfig *config,
+                                                           struct PcoWrappedCc **dst);
+
+enum PcoError pco_wrapped_file_compressor_free(struct PcoWrappedFc *fc);
+
+enum PcoError pco_wrapped_chunk_compressor_write_chunk_meta(const struct PcoWrappedCc *cc,
+                                                            struct PcoFfiVec *dst);
+
+enum PcoError pco_wrapped_chunk_compressor_n_pages(const struct PcoWrappedCc *cc,
+                                                   unsigned int *dst);
+
+enum PcoError pco_wrapped_chunk_compressor_page_n(const struct PcoWrappedCc *cc,
+                                                  unsigned int page_idx,
+                                                  unsigned int *dst);
+
+enum PcoError pco_wrapped_chunk_compressor_write_page(const struct PcoWrappedCc *cc,
+                                                      unsigned int page_idx,
+                                                      struct PcoFfiVec *dst);
+
+enum PcoError pco_wrapped_chunk_compressor_free(struct PcoWrappedCc *cc);
+
+enum PcoError pco_wrapped_file_decompressor_new(const void *src,
+                                                unsigned int len,
+                                                struct PcoWrappedFd **dst,
+                                                unsigned int *n_bytes_read);
+
+enum PcoError pco_wrapped_file_decompressor_chunk_decompressor(const struct PcoWrappedFd *fd,
+                                                               const void *src,
+                                                               unsigned int len,
+                                                               unsigned char dtype,
+                                                               struct PcoWrappedCd **dst,
+                                                               unsigned int *n_bytes_read);
+
+enum PcoError pco_wrapped_file_decompressor_free(struct PcoWrappedFd *fd);
+
+enum PcoError pco_wrapped_chunk_decompressor_decompress_page(const struct PcoWrappedCd *cd,
+                                                             const void *src,
+                                                             unsigned int len,
+                                                             unsigned int page_n,
+                                                             void *dst,
+                                                             unsigned int dst_len,
+                                                             struct PcoProgress *progress,
+                                                             unsigned int *n_bytes_read);
+
+enum PcoError pco_wrapped_chunk_decompressor_free(struct PcoWrappedCd *cd);
+
+/**
+ * Compresses `n_arrays` arrays of one dtype against a single shared chunk
+ * metadata, which the wrapped format realizes natively: the arrays become the
+ * exact pages of one chunk, so the bins and ANS tables trained over all of
+ * them are serialized once. `meta_dst` receives the header and chunk metadata;
+ * `page_dsts[i]` receives array `i`'s metadata-less page bytes. The caller's
+ * `exact_page_ns` is ignored; paging always follows the array lengths.
+ *
+ * This pays off when the arrays are small (say, thousands of values) and
+ * near-identically distributed, where per-array chunk metadata would dominate
+ * each array's bytes. The arrays must be presented together so the shared
+ * tables can be trained over all of them.
+ */
+enum PcoError pco_shared_compress(const struct PcoArray *arrays,
+                                  size_t n_arrays,
+                                  const struct PcoChunkConfig *config,
+                                  struct PcoFfiVec *meta_dst,
+                                  struct PcoFfiVec *page_dsts);
+
+/**
+ * Parses a shared metadata blob written by `pco_shared_compress` into a chunk
+ * decompressor handle. Decode each page stream with
+ * `pco_wrapped_chunk_decompressor_decompress_page`, passing its array's
+ * length as `page_n`; the parsed tables are reused across all pages. Free the
+ * handle with `pco_wrapped_chunk_decompressor_free`.
+ */
+enum PcoError pco_shared_decompressor_new(const void *meta,
+                                          unsigned int meta_len,
+                                          unsigned char dtype,
+                                          struct PcoWrappedCd **dst);
@@ -0,0 +1,237 @@
+use libc::{c_int, c_uchar, c_uint, c_void};
+
+use pco::data_types::{CoreDataType, Latent, NumberLike};
+use pco::wrapped::FileCompressor;
+use pco::{with_core_dtypes, ChunkConfig, FloatMultSpec, FloatQuantSpec, IntMultSpec, Mode};
+
+use crate::{register_err, PcoChunkConfig, PcoError, PcoFfiVec, PcoSpec};
+
+/// Opaque handle holding compression settings trained once on a sample, for
+/// compressing many similar small arrays.
+///
+/// Training compresses the sample once and pins the detected mode (with its
+/// base), delta encoding order, and paging, so later calls skip the
+/// per-array detection passes that dominate at 1k-10k element sizes. Each
+/// compressed array is still a self-contained standalone file carrying its
+/// own bins and ANS tables, since the pco format requires every chunk's
+/// tables to be derived from its own data for decodability.
+pub struct PcoContext {
+  dtype: CoreDataType,
+  config: ChunkConfig,
+}
+
+/// f64 view of a number, only needed to pin detected `FloatMult` bases back
+/// into a `FloatMultSpec::Provided`.
+trait ToF64 {
+  fn to_f64(self) -> f64;
+}
+
+macro_rules! impl_to_f64 {
+  ($($t:ty,)+) => {
+    $(impl ToF64 for $t {
+      fn to_f64(self) -> f64 {
+        self as f64
+      }
+    })+
+  }
+}
+impl_to_f64!(u16, u32, u64, i16, i32, i64, f32, f64,);
+
+impl ToF64 for half::f16 {
+  fn to_f64(self) -> f64 {
+    half::f16::to_f64(self)
+  }
+}
+
+fn _trained_config<T: NumberLike + ToF64>(
+  sample: *const c_void,
+  sample_len: c_uint,
+  config: ChunkConfig,
+) -> Result<ChunkConfig, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(sample as *const T, sample_len as usize) };
+  let result: pco::errors::PcoResult<ChunkConfig> = (|| {
+    let fc = FileCompressor::default();
+    let cc = fc.chunk_compressor::<T>(slice, &config)?;
+    let meta = cc.meta();
+
+    let mut trained = config
+      .clone()
+      .with_delta_encoding_order(Some(meta.delta_encoding_order));
+    match meta.mode {
+      Mode::Classic => {
+        trained = trained
+          .with_int_mult_spec(IntMultSpec::Disabled)
+          .with_float_mult_spec(FloatMultSpec::Disabled)
+          .with_float_quant_spec(FloatQuantSpec::Disabled);
+      }
+      Mode::IntMult(base) => {
+        trained = trained.with_int_mult_spec(IntMultSpec::Provided(base.to_u64()));
+      }
+      Mode::FloatMult(base_latent) => {
+        let base = ToF64::to_f64(T::from_latent_ordered(base_latent));
+        trained = trained.with_float_mult_spec(FloatMultSpec::Provided(base));
+      }
+      Mode::FloatQuant(k) => {
+        trained = trained.with_float_quant_spec(FloatQuantSpec::Provided(k));
+      }
+    }
+    Ok(trained)
+  })();
+  result.map_err(|e| register_err(&e))
+}
+
+/// Trains a `PcoContext` on a representative sample. A null `config` uses
+/// the default chunk config as the starting point; its specs are overridden
+/// by whatever mode and delta order the sample exhibits.
+#[no_mangle]
+pub extern "C" fn pco_context_new(
+  sample: *const c_void,
+  sample_len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut *mut PcoContext,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = if config.is_null() {
+    ChunkConfig::default()
+  } else {
+    match ChunkConfig::try_from(unsafe { &*config }) {
+      Ok(config) => config,
+      Err(e) => return e,
+    }
+  };
+
+  macro_rules! match_dtype_train {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _trained_config::<$t>(sample, sample_len, config),)+
+      }
+    }
+  }
+  let config = match with_core_dtypes!(match_dtype_train) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  unsafe { *dst = Box::into_raw(Box::new(PcoContext { dtype, config })) };
+  PcoError::PcoSuccess
+}
+
+/// Runs mode and delta order detection on a sample and writes the resulting
+/// concrete config to `dst`. Unlike a `PcoContext`, the result is a plain
+/// struct the caller can persist (e.g. in a catalog) and replay later through
+/// `pco_simple_compress` or any other config-taking entry point, converting
+/// per-chunk detection into a once-per-column cost. A null `config` starts
+/// from the default chunk config; paging and seek index settings pass through
+/// unchanged since detection only concerns mode and delta order. The output's
+/// `exact_page_ns` aliases the input's, so it stays valid only as long as
+/// that buffer does.
+#[no_mangle]
+pub extern "C" fn pco_detect_config(
+  sample: *const c_void,
+  sample_len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut PcoChunkConfig,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let mut start = std::mem::MaybeUninit::<PcoChunkConfig>::uninit();
+  if config.is_null() {
+    crate::pco_default_chunk_config(start.as_mut_ptr());
+  } else {
+    unsafe { start.as_mut_ptr().copy_from(config, 1) };
+  }
+  let mut start = unsafe { start.assume_init() };
+  let start_config = match ChunkConfig::try_from(&start) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  macro_rules! match_dtype_train {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _trained_config::<$t>(sample, sample_len, start_config),)+
+      }
+    }
+  }
+  let trained = match with_core_dtypes!(match_dtype_train) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  let (int_mult_spec, int_mult_base) = match trained.int_mult_spec {
+    IntMultSpec::Disabled => (PcoSpec::PcoSpecDisabled, 0),
+    IntMultSpec::Enabled => (PcoSpec::PcoSpecEnabled, 0),
+    IntMultSpec::Provided(base) => (PcoSpec::PcoSpecProvided, base),
+  };
+  let (float_mult_spec, float_mult_base) = match trained.float_mult_spec {
+    FloatMultSpec::Disabled => (PcoSpec::PcoSpecDisabled, 0.0),
+    FloatMultSpec::Enabled => (PcoSpec::PcoSpecEnabled, 0.0),
+    FloatMultSpec::Provided(base) => (PcoSpec::PcoSpecProvided, base),
+  };
+  let (float_quant_spec, float_quant_bits) = match trained.float_quant_spec {
+    FloatQuantSpec::Disabled => (PcoSpec::PcoSpecDisabled, 0),
+    FloatQuantSpec::Enabled => (PcoSpec::PcoSpecEnabled, 0),
+    FloatQuantSpec::Provided(k) => (PcoSpec::PcoSpecProvided, k),
+  };
+  start.compression_level = trained.compression_level as c_uint;
+  start.delta_encoding_order = trained
+    .delta_encoding_order
+    .map(|order| order as c_int)
+    .unwrap_or(-1);
+  start.int_mult_spec = int_mult_spec;
+  start.int_mult_base = int_mult_base;
+  start.float_mult_spec = float_mult_spec;
+  start.float_mult_base = float_mult_base;
+  start.float_quant_spec = float_quant_spec;
+  start.float_quant_bits = float_quant_bits;
+  unsafe { *dst = start };
+  PcoError::PcoSuccess
+}
+
+fn _context_compress<T: NumberLike>(
+  context: &PcoContext,
+  nums: *const c_void,
+  len: c_uint,
+  ffi_vec_ptr: *mut PcoFfiVec,
+) -> PcoError {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len as usize) };
+  match pco::standalone::simple_compress(slice, &context.config) {
+    Err(e) => register_err(&e),
+    Ok(v) => {
+      unsafe { (*ffi_vec_ptr).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+/// Compresses one array with the context's trained settings, skipping mode
+/// and delta order detection.
+#[no_mangle]
+pub extern "C" fn pco_context_compress(
+  context: *const PcoContext,
+  nums: *const c_void,
+  len: c_uint,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let context = unsafe { &*context };
+
+  macro_rules! match_dtype_compress {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match context.dtype {
+        $(CoreDataType::$name => _context_compress::<$t>(context, nums, len, dst),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_compress)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_context_free(context: *mut PcoContext) -> PcoError {
+  drop(unsafe { Box::from_raw(context) });
+  PcoError::PcoSuccess
+}
@@ -1,10 +1,15 @@
 #![allow(clippy::missing_safety_doc)]
 
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::cell::RefCell;
 use std::ptr;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
 
-use libc::{c_uchar, c_uint, c_void};
+use libc::{c_char, c_int, c_uchar, c_uint, c_void, size_t};
 
 use pco::data_types::{CoreDataType, NumberLike};
+use pco::errors::ErrorKind;
+use pco::{ChunkConfig, FloatMultSpec, FloatQuantSpec, IntMultSpec, PagingSpec, Progress};
 
 use crate::PcoError::PcoInvalidType;
 
@@ -12,9 +17,184 @@ use crate::PcoError::PcoInvalidType;
 pub enum PcoError {
   PcoSuccess,
   PcoInvalidType,
-  // TODO split this into the actual error kinds
+  /// Generic compression failure; retained for ABI compatibility. Newer
+  /// entry points report one of the specific kinds below instead.
   PcoCompressionError,
+  /// Generic decompression failure; retained for ABI compatibility. Newer
+  /// entry points report one of the specific kinds below instead.
   PcoDecompressionError,
+  /// Decompression reached the end of the provided bytes before finishing;
+  /// the caller should retry with more data.
+  PcoInsufficientDataError,
+  /// The compressed data requires a newer version of pco to decode.
+  PcoCompatibilityError,
+  /// The compressed data is inconsistent or violates the pco format.
+  PcoCorruptionError,
+  /// The arguments provided were invalid, e.g. a bad config or a too-small
+  /// destination buffer.
+  PcoInvalidArgumentError,
+  PcoIoError,
+  /// The operation was abandoned at a batch boundary because the handle's
+  /// deadline passed or its cancel callback fired.
+  PcoCancelledError,
+}
+
+/// Allocates `size` bytes with alignment `align`, returning null on failure.
+pub type PcoAllocFn =
+  Option<unsafe extern "C" fn(user_data: *mut c_void, size: size_t, align: size_t) -> *mut c_void>;
+/// Frees a pointer previously returned by the paired `PcoAllocFn` with the
+/// same size and alignment.
+pub type PcoFreeFn = Option<
+  unsafe extern "C" fn(user_data: *mut c_void, ptr: *mut c_void, size: size_t, align: size_t),
+>;
+
+static N_ALLOCS: AtomicU64 = AtomicU64::new(0);
+static N_ALLOC_BYTES: AtomicU64 = AtomicU64::new(0);
+
+static ALLOC_FN: AtomicUsize = AtomicUsize::new(0);
+static FREE_FN: AtomicUsize = AtomicUsize::new(0);
+static ALLOC_USER_DATA: AtomicUsize = AtomicUsize::new(0);
+
+/// Routes every allocation in this library (compressed output, decompressed
+/// vectors, and internal scratch) through the caller's allocator once
+/// `pco_set_allocator` has been called, and through the system allocator
+/// otherwise.
+struct FfiAlloc;
+
+unsafe impl GlobalAlloc for FfiAlloc {
+  unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+    N_ALLOCS.fetch_add(1, Ordering::Relaxed);
+    N_ALLOC_BYTES.fetch_add(layout.size() as u64, Ordering::Relaxed);
+    let alloc_fn = ALLOC_FN.load(Ordering::Acquire);
+    if alloc_fn == 0 {
+      return System.alloc(layout);
+    }
+    let alloc_fn: PcoAllocFn = std::mem::transmute(alloc_fn);
+    let user_data = ALLOC_USER_DATA.load(Ordering::Acquire) as *mut c_void;
+    alloc_fn.unwrap_unchecked()(user_data, layout.size(), layout.align()) as *mut u8
+  }
+
+  unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+    let free_fn = FREE_FN.load(Ordering::Acquire);
+    if free_fn == 0 {
+      return System.dealloc(ptr, layout);
+    }
+    let free_fn: PcoFreeFn = std::mem::transmute(free_fn);
+    let user_data = ALLOC_USER_DATA.load(Ordering::Acquire) as *mut c_void;
+    free_fn.unwrap_unchecked()(
+      user_data,
+      ptr as *mut c_void,
+      layout.size(),
+      layout.align(),
+    )
+  }
+}
+
+#[global_allocator]
+static GLOBAL_ALLOC: FfiAlloc = FfiAlloc;
+
+/// Makes all future allocations go through `alloc_fn`/`free_fn`, e.g. to pin
+/// decompressed columns to a particular NUMA node's arena.
+///
+/// Must be called before any other pco function so no buffer allocated by the
+/// previous allocator gets freed by the new one; for the same reason it may
+/// only be called once. Passing null for both functions is an error rather
+/// than a reset.
+#[no_mangle]
+pub extern "C" fn pco_set_allocator(
+  alloc_fn: PcoAllocFn,
+  free_fn: PcoFreeFn,
+  user_data: *mut c_void,
+) -> PcoError {
+  let (Some(alloc_fn), Some(free_fn)) = (alloc_fn, free_fn) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "both alloc_fn and free_fn must be provided",
+    );
+  };
+  if ALLOC_FN.load(Ordering::Acquire) != 0 {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "the allocator may only be set once",
+    );
+  }
+  ALLOC_USER_DATA.store(user_data as usize, Ordering::Release);
+  FREE_FN.store(free_fn as usize, Ordering::Release);
+  ALLOC_FN.store(alloc_fn as usize, Ordering::Release);
+  PcoError::PcoSuccess
+}
+
+/// Reports the library-wide count of heap allocations and allocated bytes
+/// since load. The counters are monotonic and never reset, so subtracting
+/// successive readings attributes allocations to the calls in between. The
+/// binding layer performs no per-chunk allocations on the streaming decode
+/// path; the difference across a steady-state scan therefore measures the
+/// core's per-chunk scratch, and a growing per-call delta indicates a
+/// regression in the allocation profile.
+#[no_mangle]
+pub extern "C" fn pco_alloc_stats(n_allocs: *mut u64, n_bytes: *mut u64) -> PcoError {
+  unsafe {
+    *n_allocs = N_ALLOCS.load(Ordering::Relaxed);
+    *n_bytes = N_ALLOC_BYTES.load(Ordering::Relaxed);
+  }
+  PcoError::PcoSuccess
+}
+
+thread_local! {
+  static LAST_ERROR_MESSAGE: RefCell<String> = RefCell::new(String::new());
+}
+
+/// Records the message of a pco error for `pco_last_error_message` and
+/// converts its kind to the C enum.
+pub(crate) fn register_err(e: &pco::errors::PcoError) -> PcoError {
+  LAST_ERROR_MESSAGE.with(|m| *m.borrow_mut() = e.to_string());
+  match e.kind {
+    ErrorKind::Compatibility => PcoError::PcoCompatibilityError,
+    ErrorKind::Corruption => PcoError::PcoCorruptionError,
+    ErrorKind::InsufficientData => PcoError::PcoInsufficientDataError,
+    ErrorKind::InvalidArgument => PcoError::PcoInvalidArgumentError,
+    ErrorKind::Io(_) => PcoError::PcoIoError,
+    // ErrorKind is non_exhaustive, so future kinds fall back to the old
+    // catch-all code
+    _ => PcoError::PcoDecompressionError,
+  }
+}
+
+/// Like `register_err`, but for errors originating in these bindings rather
+/// than in pco itself.
+pub(crate) fn register_local_err(code: PcoError, message: &str) -> PcoError {
+  LAST_ERROR_MESSAGE.with(|m| {
+    m.borrow_mut().clear();
+    m.borrow_mut().push_str(message);
+  });
+  code
+}
+
+/// Copies the message of the most recent error on this thread into `dst` as a
+/// NUL-terminated string, truncating to `dst_capacity` bytes (including the
+/// NUL) if necessary.
+#[no_mangle]
+pub extern "C" fn pco_last_error_message(dst: *mut c_char, dst_capacity: size_t) -> PcoError {
+  if dst.is_null() || dst_capacity == 0 {
+    return PcoError::PcoInvalidArgumentError;
+  }
+  LAST_ERROR_MESSAGE.with(|m| {
+    let message = m.borrow();
+    let mut n_bytes = message.len().min(dst_capacity - 1);
+    // avoid splitting a UTF-8 character
+    while n_bytes > 0 && !message.is_char_boundary(n_bytes) {
+      n_bytes -= 1;
+    }
+    unsafe {
+      ptr::copy_nonoverlapping(
+        message.as_ptr() as *const c_char,
+        dst,
+        n_bytes,
+      );
+      *dst.add(n_bytes) = 0;
+    }
+  });
+  PcoError::PcoSuccess
 }
 
 macro_rules! impl_dtypes {
@@ -48,11 +228,149 @@ macro_rules! impl_dtypes {
 
 pco::with_core_dtypes!(impl_dtypes);
 
+mod context;
+#[cfg(unix)]
+mod mapped;
+mod simd;
+mod standalone;
+mod wrapped;
+
+/// Mirrors the `Disabled`/`Enabled`/`Provided` shape shared by
+/// `IntMultSpec`, `FloatMultSpec`, and `FloatQuantSpec`.
+/// When `Provided` is used, the accompanying value field in `PcoChunkConfig`
+/// supplies the base (or bit count, for float quantization).
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub enum PcoSpec {
+  PcoSpecDisabled,
+  PcoSpecEnabled,
+  PcoSpecProvided,
+}
+
+/// Mirrors `pco::ChunkConfig`; see that struct for the meaning of each
+/// configuration.
+///
+/// Use `pco_default_chunk_config` to fill one of these with default values
+/// before overriding the fields you care about.
+#[repr(C)]
+pub struct PcoChunkConfig {
+  compression_level: c_uint,
+  /// 0 through 7, or -1 to automatically detect the delta encoding order on
+  /// each chunk.
+  delta_encoding_order: c_int,
+  int_mult_spec: PcoSpec,
+  int_mult_base: u64,
+  float_mult_spec: PcoSpec,
+  float_mult_base: f64,
+  float_quant_spec: PcoSpec,
+  float_quant_bits: c_uint,
+  /// If `exact_page_ns` is null, chunks are split into equal pages of up to
+  /// `max_page_n` numbers; otherwise pages get exactly the provided counts.
+  max_page_n: c_uint,
+  exact_page_ns: *const c_uint,
+  n_exact_pages: c_uint,
+  /// If nonzero, `pco_simple_compress` appends a seek index after the
+  /// standalone terminator byte: per-chunk byte offsets and cumulative
+  /// number counts, costing 8 bytes per chunk. pco readers stop at the
+  /// terminator, so indexed files stay decodable everywhere, but
+  /// `pco_decompress_range` and `pco_parse_seek_index` use the index to
+  /// jump straight to a chunk instead of decoding everything before it.
+  enable_seek_index: c_uchar,
+}
+
+impl TryFrom<&PcoChunkConfig> for ChunkConfig {
+  type Error = PcoError;
+
+  fn try_from(config: &PcoChunkConfig) -> Result<Self, Self::Error> {
+    let delta_encoding_order = match config.delta_encoding_order {
+      -1 => None,
+      order if order >= 0 => Some(order as usize),
+      _ => {
+        return Err(register_local_err(
+          PcoError::PcoInvalidArgumentError,
+          "delta_encoding_order must be between -1 and 7",
+        ))
+      }
+    };
+    let int_mult_spec = match config.int_mult_spec {
+      PcoSpec::PcoSpecDisabled => IntMultSpec::Disabled,
+      PcoSpec::PcoSpecEnabled => IntMultSpec::Enabled,
+      PcoSpec::PcoSpecProvided => IntMultSpec::Provided(config.int_mult_base),
+    };
+    let float_mult_spec = match config.float_mult_spec {
+      PcoSpec::PcoSpecDisabled => FloatMultSpec::Disabled,
+      PcoSpec::PcoSpecEnabled => FloatMultSpec::Enabled,
+      PcoSpec::PcoSpecProvided => FloatMultSpec::Provided(config.float_mult_base),
+    };
+    let float_quant_spec = match config.float_quant_spec {
+      PcoSpec::PcoSpecDisabled => FloatQuantSpec::Disabled,
+      PcoSpec::PcoSpecEnabled => FloatQuantSpec::Enabled,
+      PcoSpec::PcoSpecProvided => FloatQuantSpec::Provided(config.float_quant_bits),
+    };
+    let paging_spec = if config.exact_page_ns.is_null() {
+      PagingSpec::EqualPagesUpTo(config.max_page_n as usize)
+    } else {
+      let page_ns = unsafe {
+        std::slice::from_raw_parts(
+          config.exact_page_ns,
+          config.n_exact_pages as usize,
+        )
+      };
+      PagingSpec::Exact(page_ns.iter().map(|&n| n as usize).collect())
+    };
+
+    Ok(
+      ChunkConfig::default()
+        .with_compression_level(config.compression_level as usize)
+        .with_delta_encoding_order(delta_encoding_order)
+        .with_int_mult_spec(int_mult_spec)
+        .with_float_mult_spec(float_mult_spec)
+        .with_float_quant_spec(float_quant_spec)
+        .with_paging_spec(paging_spec),
+    )
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_default_chunk_config(dst: *mut PcoChunkConfig) -> PcoError {
+  unsafe {
+    *dst = PcoChunkConfig {
+      compression_level: pco::DEFAULT_COMPRESSION_LEVEL as c_uint,
+      delta_encoding_order: -1,
+      int_mult_spec: PcoSpec::PcoSpecEnabled,
+      int_mult_base: 0,
+      float_mult_spec: PcoSpec::PcoSpecEnabled,
+      float_mult_base: 0.0,
+      float_quant_spec: PcoSpec::PcoSpecEnabled,
+      float_quant_bits: 0,
+      max_page_n: pco::DEFAULT_MAX_PAGE_N as c_uint,
+      exact_page_ns: ptr::null(),
+      n_exact_pages: 0,
+      enable_seek_index: 0,
+    };
+  }
+  PcoError::PcoSuccess
+}
+
+#[repr(C)]
+pub struct PcoProgress {
+  n_processed: c_uint,
+  finished: c_uchar,
+}
+
+/// Like `PcoProgress`, but with a `size_t` count for columns of 2^32 or more
+/// numbers.
+#[repr(C)]
+pub struct PcoProgress64 {
+  n_processed: size_t,
+  finished: c_uchar,
+}
+
 #[repr(C)]
 pub struct PcoFfiVec {
-  ptr: *const c_void,
-  len: c_uint,
-  raw_box: *const c_void,
+  pub ptr: *const c_void,
+  pub len: c_uint,
+  pub raw_box: *const c_void,
 }
 
 impl PcoFfiVec {
@@ -77,15 +395,75 @@ impl PcoFfiVec {
   }
 }
 
+/// Like `PcoFfiVec`, but with a `size_t` length for columns of 2^32 or more
+/// numbers.
+#[repr(C)]
+pub struct PcoFfiVec64 {
+  ptr: *const c_void,
+  len: size_t,
+  raw_box: *const c_void,
+}
+
+impl PcoFfiVec64 {
+  fn init_from_vec<T>(&mut self, v: Vec<T>)
+  where
+    Vec<T>: Into<DynTypedVec>,
+  {
+    self.ptr = v.as_ptr() as *const c_void;
+    self.len = v.len();
+    self.raw_box = Box::into_raw(Box::new(v.into())) as *const c_void;
+  }
+
+  fn free(&mut self) {
+    unsafe {
+      drop(Box::from_raw(
+        self.raw_box as *mut DynTypedVec,
+      ));
+    }
+    self.ptr = ptr::null();
+    self.len = 0;
+    self.raw_box = ptr::null();
+  }
+}
+
 fn _simpler_compress<T: NumberLike>(
   nums: *const c_void,
-  len: c_uint,
+  len: size_t,
   level: c_uint,
+) -> Result<Vec<u8>, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len) };
+  pco::standalone::simpler_compress(slice, level as usize).map_err(|e| register_err(&e))
+}
+
+fn _simple_compress<T: NumberLike>(
+  nums: *const c_void,
+  len: size_t,
+  config: &ChunkConfig,
+) -> Result<Vec<u8>, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len) };
+  pco::standalone::simple_compress(slice, config).map_err(|e| register_err(&e))
+}
+
+fn _simple_compress_indexed<T: NumberLike>(
+  nums: *const c_void,
+  len: size_t,
+  config: &ChunkConfig,
+) -> Result<Vec<u8>, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len) };
+  standalone::simple_compress_indexed(slice, config)
+}
+
+fn _simple_decompress<T: NumberLike>(
+  compressed: *const c_void,
+  len: size_t,
   ffi_vec_ptr: *mut PcoFfiVec,
-) -> PcoError {
-  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len as usize) };
-  match pco::standalone::simpler_compress(slice, level as usize) {
-    Err(_) => PcoError::PcoCompressionError,
+) -> PcoError
+where
+  Vec<T>: Into<DynTypedVec>,
+{
+  let slice = unsafe { std::slice::from_raw_parts(compressed as *const u8, len) };
+  match pco::standalone::simple_decompress::<T>(slice) {
+    Err(e) => register_err(&e),
     Ok(v) => {
       unsafe { (*ffi_vec_ptr).init_from_vec(v) };
       PcoError::PcoSuccess
@@ -93,17 +471,17 @@ fn _simpler_compress<T: NumberLike>(
   }
 }
 
-fn _simple_decompress<T: NumberLike>(
+fn _simple_decompress64<T: NumberLike>(
   compressed: *const c_void,
-  len: c_uint,
-  ffi_vec_ptr: *mut PcoFfiVec,
+  len: size_t,
+  ffi_vec_ptr: *mut PcoFfiVec64,
 ) -> PcoError
 where
   Vec<T>: Into<DynTypedVec>,
 {
-  let slice = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let slice = unsafe { std::slice::from_raw_parts(compressed as *const u8, len) };
   match pco::standalone::simple_decompress::<T>(slice) {
-    Err(_) => PcoError::PcoDecompressionError,
+    Err(e) => register_err(&e),
     Ok(v) => {
       unsafe { (*ffi_vec_ptr).init_from_vec(v) };
       PcoError::PcoSuccess
@@ -111,6 +489,17 @@ where
   }
 }
 
+fn _simple_decompress_into<T: NumberLike>(
+  compressed: *const c_void,
+  len: size_t,
+  dst: *mut c_void,
+  dst_len: size_t,
+) -> Result<Progress, PcoError> {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len) };
+  let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut T, dst_len) };
+  pco::standalone::simple_decompress_into::<T>(src, dst).map_err(|e| register_err(&e))
+}
+
 #[no_mangle]
 pub extern "C" fn pco_simpler_compress(
   nums: *const c_void,
@@ -123,11 +512,112 @@ pub extern "C" fn pco_simpler_compress(
     return PcoInvalidType;
   };
 
-  match_dtype!(
+  match match_dtype!(
     dtype,
     _simpler_compress,
-    (nums, len, level, dst)
-  )
+    (nums, len as size_t, level)
+  ) {
+    Err(e) => e,
+    Ok(v) => {
+      unsafe { (*dst).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_simpler_compress64(
+  nums: *const c_void,
+  len: size_t,
+  dtype: c_uchar,
+  level: c_uint,
+  dst: *mut PcoFfiVec64,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+
+  match match_dtype!(dtype, _simpler_compress, (nums, len, level)) {
+    Err(e) => e,
+    Ok(v) => {
+      unsafe { (*dst).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_simple_compress(
+  nums: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+  let with_index = unsafe { (*config).enable_seek_index != 0 };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  let result = if with_index {
+    match_dtype!(
+      dtype,
+      _simple_compress_indexed,
+      (nums, len as size_t, &config)
+    )
+  } else {
+    match_dtype!(
+      dtype,
+      _simple_compress,
+      (nums, len as size_t, &config)
+    )
+  };
+  match result {
+    Err(e) => e,
+    Ok(v) => {
+      unsafe { (*dst).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_simple_compress64(
+  nums: *const c_void,
+  len: size_t,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut PcoFfiVec64,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+  let with_index = unsafe { (*config).enable_seek_index != 0 };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  let result = if with_index {
+    match_dtype!(
+      dtype,
+      _simple_compress_indexed,
+      (nums, len, &config)
+    )
+  } else {
+    match_dtype!(dtype, _simple_compress, (nums, len, &config))
+  };
+  match result {
+    Err(e) => e,
+    Ok(v) => {
+      unsafe { (*dst).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
 }
 
 #[no_mangle]
@@ -144,10 +634,97 @@ pub extern "C" fn pco_simple_decompress(
   match_dtype!(
     dtype,
     _simple_decompress,
+    (compressed, len as size_t, dst)
+  )
+}
+
+#[no_mangle]
+pub extern "C" fn pco_simple_decompress64(
+  compressed: *const c_void,
+  len: size_t,
+  dtype: c_uchar,
+  dst: *mut PcoFfiVec64,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+
+  match_dtype!(
+    dtype,
+    _simple_decompress64,
     (compressed, len, dst)
   )
 }
 
+#[no_mangle]
+pub extern "C" fn pco_simple_decompress_into(
+  compressed: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  dst: *mut c_void,
+  dst_len: c_uint,
+  progress: *mut PcoProgress,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+
+  match match_dtype!(
+    dtype,
+    _simple_decompress_into,
+    (
+      compressed,
+      len as size_t,
+      dst,
+      dst_len as size_t
+    )
+  ) {
+    Err(e) => e,
+    Ok(p) => {
+      unsafe {
+        (*progress).n_processed = p.n_processed as c_uint;
+        (*progress).finished = p.finished as c_uchar;
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_simple_decompress_into64(
+  compressed: *const c_void,
+  len: size_t,
+  dtype: c_uchar,
+  dst: *mut c_void,
+  dst_len: size_t,
+  progress: *mut PcoProgress64,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoInvalidType;
+  };
+
+  match match_dtype!(
+    dtype,
+    _simple_decompress_into,
+    (compressed, len, dst, dst_len)
+  ) {
+    Err(e) => e,
+    Ok(p) => {
+      unsafe {
+        (*progress).n_processed = p.n_processed;
+        (*progress).finished = p.finished as c_uchar;
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_free_pcovec64(ffi_vec: *mut PcoFfiVec64) -> PcoError {
+  unsafe { (*ffi_vec).free() };
+  PcoError::PcoSuccess
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn pco_free_pcovec(ffi_vec: *mut PcoFfiVec) -> PcoError {
   unsafe { (*ffi_vec).free() };
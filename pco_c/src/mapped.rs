@@ -0,0 +1,164 @@
+use std::ffi::CStr;
+use std::os::unix::io::AsRawFd;
+use std::ptr;
+
+use libc::{c_char, c_uchar, c_uint, c_void, size_t};
+
+use pco::standalone::FileDecompressor;
+
+use crate::{register_err, register_local_err, PcoError};
+
+/// Opaque handle to a memory-mapped standalone file (POSIX only).
+///
+/// Opening parses only the header and the first chunk's data type byte;
+/// pages are decoded on demand through the range and streaming entry points
+/// over the mapped bytes, so the file is never copied into RAM wholesale and
+/// the OS page cache serves repeated partial scans.
+pub struct PcoMapped {
+  ptr: *mut c_void,
+  len: size_t,
+  inner: FileDecompressor,
+  first_dtype_byte: c_uchar,
+}
+
+fn io_err(message: String) -> PcoError {
+  register_local_err(PcoError::PcoIoError, &message)
+}
+
+/// Memory-maps the standalone file at `path` (a NUL-terminated UTF-8 path)
+/// read-only and parses its header.
+#[no_mangle]
+pub extern "C" fn pco_open_mapped(path: *const c_char, dst: *mut *mut PcoMapped) -> PcoError {
+  let path = match unsafe { CStr::from_ptr(path) }.to_str() {
+    Ok(path) => path,
+    Err(_) => {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "path is not valid UTF-8",
+      )
+    }
+  };
+  let file = match std::fs::File::open(path) {
+    Ok(file) => file,
+    Err(e) => return io_err(format!("failed to open {}: {}", path, e)),
+  };
+  let len = match file.metadata() {
+    Ok(metadata) => metadata.len() as size_t,
+    Err(e) => return io_err(format!("failed to stat {}: {}", path, e)),
+  };
+  if len == 0 {
+    return io_err(format!("{} is empty", path));
+  }
+
+  let ptr = unsafe {
+    libc::mmap(
+      ptr::null_mut(),
+      len,
+      libc::PROT_READ,
+      libc::MAP_PRIVATE,
+      file.as_raw_fd(),
+      0,
+    )
+  };
+  if ptr == libc::MAP_FAILED {
+    return io_err(format!(
+      "failed to mmap {}: {}",
+      path,
+      std::io::Error::last_os_error()
+    ));
+  }
+
+  let src = unsafe { std::slice::from_raw_parts(ptr as *const u8, len) };
+  let parsed: pco::errors::PcoResult<_> = (|| {
+    let (fd, rest) = FileDecompressor::new(src)?;
+    let first_dtype_byte = u8::from(fd.peek_dtype_or_termination(rest)?);
+    Ok((fd, first_dtype_byte))
+  })();
+  let (inner, first_dtype_byte) = match parsed {
+    Ok(x) => x,
+    Err(e) => {
+      unsafe { libc::munmap(ptr, len) };
+      return register_err(&e);
+    }
+  };
+
+  unsafe {
+    *dst = Box::into_raw(Box::new(PcoMapped {
+      ptr,
+      len,
+      inner,
+      first_dtype_byte,
+    }))
+  };
+  PcoError::PcoSuccess
+}
+
+/// Exposes the mapped bytes so any decompression entry point can run over
+/// them zero-copy. The pointer stays valid until `pco_close_mapped`.
+#[no_mangle]
+pub extern "C" fn pco_mapped_bytes(
+  mapped: *const PcoMapped,
+  ptr: *mut *const c_void,
+  len: *mut size_t,
+) -> PcoError {
+  let mapped = unsafe { &*mapped };
+  unsafe {
+    *ptr = mapped.ptr;
+    *len = mapped.len;
+  }
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_mapped_n_hint(mapped: *const PcoMapped, dst: *mut c_uint) -> PcoError {
+  let mapped = unsafe { &*mapped };
+  unsafe { *dst = mapped.inner.n_hint() as c_uint };
+  PcoError::PcoSuccess
+}
+
+/// The data type byte of the file's first chunk, or 0 if it has no chunks,
+/// so callers need not know the dtype out of band.
+#[no_mangle]
+pub extern "C" fn pco_mapped_dtype(mapped: *const PcoMapped, dst: *mut c_uchar) -> PcoError {
+  let mapped = unsafe { &*mapped };
+  unsafe { *dst = mapped.first_dtype_byte };
+  PcoError::PcoSuccess
+}
+
+/// Decodes only the numbers in `[start_idx, end_idx)`, faulting in just the
+/// mapped pages the decode touches.
+#[no_mangle]
+pub extern "C" fn pco_mapped_decompress_range(
+  mapped: *const PcoMapped,
+  dtype: c_uchar,
+  start_idx: c_uint,
+  end_idx: c_uint,
+  dst: *mut c_void,
+  n: *mut c_uint,
+) -> PcoError {
+  let mapped = unsafe { &*mapped };
+  // the range decoder takes a 32-bit length; casting a longer mapping would
+  // silently truncate it
+  if mapped.len > c_uint::MAX as size_t {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "the mapped file is too long for a 32-bit byte count",
+    );
+  }
+  crate::standalone::pco_decompress_range(
+    mapped.ptr,
+    mapped.len as c_uint,
+    dtype,
+    start_idx,
+    end_idx,
+    dst,
+    n,
+  )
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_close_mapped(mapped: *mut PcoMapped) -> PcoError {
+  let mapped = unsafe { Box::from_raw(mapped) };
+  unsafe { libc::munmap(mapped.ptr, mapped.len) };
+  PcoError::PcoSuccess
+}
@@ -0,0 +1,118 @@
+use libc::c_uchar;
+
+use crate::PcoError;
+
+/// CPU capability report for confirming which code paths a deployed artifact
+/// can take; each flag is 0 or 1.
+///
+/// The `detected_` flags reflect the machine at runtime; the `compiled_`
+/// flags reflect the target features the artifact was built to assume
+/// unconditionally. A feature that is detected but not compiled in is still
+/// used by the runtime-dispatched kernels, which carry their own per-feature
+/// code paths.
+#[repr(C)]
+pub struct PcoCpuFeatures {
+  detected_avx2: c_uchar,
+  detected_avx512f: c_uchar,
+  detected_neon: c_uchar,
+  compiled_avx2: c_uchar,
+  compiled_avx512f: c_uchar,
+  compiled_neon: c_uchar,
+}
+
+/// Fills `dst` with the CPU features detected at runtime and the target
+/// features this artifact was compiled with.
+#[no_mangle]
+pub extern "C" fn pco_cpu_features(dst: *mut PcoCpuFeatures) -> PcoError {
+  #[cfg(target_arch = "x86_64")]
+  let (detected_avx2, detected_avx512f) = (
+    std::arch::is_x86_feature_detected!("avx2") as c_uchar,
+    std::arch::is_x86_feature_detected!("avx512f") as c_uchar,
+  );
+  #[cfg(not(target_arch = "x86_64"))]
+  let (detected_avx2, detected_avx512f) = (0, 0);
+  // the aarch64 baseline includes NEON, so detection is a compile-time fact
+  let detected_neon = cfg!(target_arch = "aarch64") as c_uchar;
+  unsafe {
+    *dst = PcoCpuFeatures {
+      detected_avx2,
+      detected_avx512f,
+      detected_neon,
+      compiled_avx2: cfg!(target_feature = "avx2") as c_uchar,
+      compiled_avx512f: cfg!(target_feature = "avx512f") as c_uchar,
+      compiled_neon: cfg!(target_feature = "neon") as c_uchar,
+    };
+  }
+  PcoError::PcoSuccess
+}
+
+/// Defines one batch narrowing kernel with runtime dispatch: the same loop
+/// body is compiled once per feature tier (the `target_feature` attribute
+/// lets the compiler emit 256- or 512-bit conversions for it) and the widest
+/// tier the machine supports is picked per call. `is_x86_feature_detected!`
+/// caches its answer, so dispatch costs an atomic load.
+macro_rules! impl_cast_kernel {
+  ($dispatch:ident, $scalar:ident, $avx2:ident, $avx512:ident, $s:ty, $d:ty) => {
+    fn $scalar(src: &[$s], dst: &mut [$d]) {
+      for (&x, out) in src.iter().zip(dst.iter_mut()) {
+        *out = x as $d;
+      }
+    }
+
+    #[cfg(target_arch = "x86_64")]
+    #[target_feature(enable = "avx2")]
+    unsafe fn $avx2(src: &[$s], dst: &mut [$d]) {
+      for (&x, out) in src.iter().zip(dst.iter_mut()) {
+        *out = x as $d;
+      }
+    }
+
+    #[cfg(target_arch = "x86_64")]
+    #[target_feature(enable = "avx512f")]
+    unsafe fn $avx512(src: &[$s], dst: &mut [$d]) {
+      for (&x, out) in src.iter().zip(dst.iter_mut()) {
+        *out = x as $d;
+      }
+    }
+
+    pub(crate) fn $dispatch(src: &[$s], dst: &mut [$d]) {
+      #[cfg(target_arch = "x86_64")]
+      {
+        if std::arch::is_x86_feature_detected!("avx512f") {
+          return unsafe { $avx512(src, dst) };
+        }
+        if std::arch::is_x86_feature_detected!("avx2") {
+          return unsafe { $avx2(src, dst) };
+        }
+      }
+      // NEON is in the aarch64 baseline, so the scalar kernel already
+      // vectorizes there
+      $scalar(src, dst)
+    }
+  };
+}
+
+impl_cast_kernel!(
+  cast_f64_to_f32,
+  cast_f64_to_f32_scalar,
+  cast_f64_to_f32_avx2,
+  cast_f64_to_f32_avx512,
+  f64,
+  f32
+);
+impl_cast_kernel!(
+  cast_i64_to_i32,
+  cast_i64_to_i32_scalar,
+  cast_i64_to_i32_avx2,
+  cast_i64_to_i32_avx512,
+  i64,
+  i32
+);
+impl_cast_kernel!(
+  cast_u64_to_u32,
+  cast_u64_to_u32_scalar,
+  cast_u64_to_u32_avx2,
+  cast_u64_to_u32_avx512,
+  u64,
+  u32
+);
@@ -0,0 +1,1981 @@
+use std::cell::Cell;
+use std::sync::Mutex;
+use std::thread;
+use std::time::Instant;
+
+use libc::{c_uchar, c_uint, c_void, size_t};
+
+use pco::data_types::{CoreDataType, Latent, NumberLike};
+use pco::standalone::{guarantee, FileCompressor, FileDecompressor, MaybeChunkDecompressor};
+use pco::{with_core_dtypes, ChunkConfig, Mode, PagingSpec, FULL_BATCH_N};
+
+use crate::{register_err, register_local_err, PcoChunkConfig, PcoError, PcoFfiVec};
+
+/// Returns nonzero if the operation should be cancelled; polled at batch
+/// boundaries during decompression.
+pub type PcoCancelFn = Option<unsafe extern "C" fn(user_data: *mut c_void) -> c_uchar>;
+
+/// Opaque handle wrapping `pco::standalone::FileDecompressor`.
+///
+/// Unlike `pco_simple_decompress`, this allows decoding a standalone file one
+/// chunk at a time, so disk reads can be overlapped with decompression and
+/// only one chunk's worth of compressed bytes needs to be resident.
+pub struct PcoDecompressor {
+  inner: FileDecompressor,
+  dtype: CoreDataType,
+  stats: Cell<PcoStats>,
+  deadline: Cell<Option<Instant>>,
+  cancel_fn: Cell<PcoCancelFn>,
+  cancel_user_data: Cell<*mut c_void>,
+  pending: Cell<Option<thread::JoinHandle<AsyncOutcome>>>,
+}
+
+/// Result of a worker-thread chunk decode, reported back on the caller's
+/// thread by `pco_decompressor_await_chunk` so error messages land in the
+/// caller's thread-local slot.
+enum AsyncOutcome {
+  Done {
+    n: usize,
+    n_bytes_read: usize,
+    meta_nanos: u64,
+    page_nanos: u64,
+  },
+  Capacity {
+    chunk_n: usize,
+  },
+  Failed(pco::errors::PcoError),
+}
+
+impl PcoDecompressor {
+  fn is_interruptible(&self) -> bool {
+    self.deadline.get().is_some() || self.cancel_fn.get().is_some()
+  }
+
+  fn check_interrupt(&self) -> Option<PcoError> {
+    if let Some(deadline) = self.deadline.get() {
+      if Instant::now() >= deadline {
+        return Some(register_local_err(
+          PcoError::PcoCancelledError,
+          "the decompression deadline was exceeded",
+        ));
+      }
+    }
+    if let Some(cancel_fn) = self.cancel_fn.get() {
+      if unsafe { cancel_fn(self.cancel_user_data.get()) } != 0 {
+        return Some(register_local_err(
+          PcoError::PcoCancelledError,
+          "the decompression was cancelled by the callback",
+        ));
+      }
+    }
+    None
+  }
+}
+
+/// Per-handle performance counters, separating chunk metadata work from page
+/// coding so slow scans can be attributed by phase. The cost is two clock
+/// reads per chunk, cheap enough to leave on in production.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct PcoStats {
+  /// Nanoseconds spent on chunk metadata: mode and delta detection, bin
+  /// optimization, and ANS table setup.
+  meta_nanos: u64,
+  /// Nanoseconds spent encoding or decoding pages.
+  page_nanos: u64,
+  /// The count of numbers pushed through the handle.
+  n_processed: u64,
+  /// The count of compressed bytes produced or consumed.
+  n_bytes: u64,
+}
+
+/// Header-level facts about a standalone file, readable without decoding
+/// any chunk.
+#[repr(C)]
+pub struct PcoFileStats {
+  /// The count of numbers in the file as recorded in its header.
+  /// Files written by pco record this exactly; files written by other
+  /// implementations or old standalone versions may record 0 instead.
+  n_hint: c_uint,
+  format_version: c_uchar,
+  /// The data type byte of the first chunk, or 0 if the file has no chunks.
+  first_dtype_byte: c_uchar,
+  /// The count of header bytes before the first chunk.
+  header_size: c_uint,
+}
+
+#[no_mangle]
+pub extern "C" fn pco_file_stats(
+  compressed: *const c_void,
+  len: c_uint,
+  dst: *mut PcoFileStats,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let (fd, rest) = match FileDecompressor::new(src) {
+    Err(e) => return register_err(&e),
+    Ok(x) => x,
+  };
+  let first_dtype_byte = match fd.peek_dtype_or_termination(rest) {
+    Err(e) => return register_err(&e),
+    Ok(dtype_or_termination) => u8::from(dtype_or_termination),
+  };
+  unsafe {
+    *dst = PcoFileStats {
+      n_hint: fd.n_hint() as c_uint,
+      format_version: fd.format_version(),
+      first_dtype_byte,
+      header_size: (src.len() - rest.len()) as c_uint,
+    };
+  }
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_peek_num_count(
+  compressed: *const c_void,
+  len: c_uint,
+  dst: *mut c_uint,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  match FileDecompressor::new(src) {
+    Err(e) => register_err(&e),
+    Ok((fd, _)) => {
+      unsafe { *dst = fd.n_hint() as c_uint };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+/// Mirrors the discriminant of `pco::Mode`.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub enum PcoMode {
+  PcoModeClassic,
+  PcoModeIntMult,
+  PcoModeFloatMult,
+  PcoModeFloatQuant,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct PcoLatentVarStats {
+  n_bins: c_uint,
+  ans_size_log: c_uint,
+}
+
+/// Metadata about a chunk, mirroring what `pco_cli inspect` reports,
+/// readable without decoding any page.
+#[repr(C)]
+pub struct PcoChunkStats {
+  /// The count of numbers in the chunk.
+  n: c_uint,
+  mode: PcoMode,
+  /// The value accompanying the mode: the base as raw latent bits for
+  /// `IntMult`/`FloatMult`, the bit count for `FloatQuant`, and 0 for
+  /// `Classic`.
+  mode_value: u64,
+  delta_encoding_order: c_uint,
+  /// Either 1 or 2; `Classic` mode has a single latent variable and the
+  /// other modes add an adjustment variable.
+  n_latent_vars: c_uint,
+  latent_vars: [PcoLatentVarStats; 2],
+}
+
+fn _inspect<T: NumberLike>(src: &[u8], dst: *mut PcoChunkStats) -> PcoError {
+  let result: pco::errors::PcoResult<_> = (|| {
+    let (fd, rest) = FileDecompressor::new(src)?;
+    Ok(match fd.chunk_decompressor::<T, _>(rest)? {
+      MaybeChunkDecompressor::EndOfData(_) => None,
+      MaybeChunkDecompressor::Some(cd) => Some((cd.n(), cd.meta().clone())),
+    })
+  })();
+  let (n, meta) = match result {
+    Err(e) => return register_err(&e),
+    Ok(None) => {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "the file contains no chunks to inspect",
+      )
+    }
+    Ok(Some(x)) => x,
+  };
+
+  let (mode, mode_value) = match meta.mode {
+    Mode::Classic => (PcoMode::PcoModeClassic, 0),
+    Mode::IntMult(base) => (PcoMode::PcoModeIntMult, base.to_u64()),
+    Mode::FloatMult(base) => (PcoMode::PcoModeFloatMult, base.to_u64()),
+    Mode::FloatQuant(k) => (PcoMode::PcoModeFloatQuant, k as u64),
+  };
+  let mut latent_vars = [PcoLatentVarStats {
+    n_bins: 0,
+    ans_size_log: 0,
+  }; 2];
+  for (latent_var, meta) in latent_vars.iter_mut().zip(&meta.per_latent_var) {
+    latent_var.n_bins = meta.bins.len() as c_uint;
+    latent_var.ans_size_log = meta.ans_size_log as c_uint;
+  }
+  unsafe {
+    *dst = PcoChunkStats {
+      n: n as c_uint,
+      mode,
+      mode_value,
+      delta_encoding_order: meta.delta_encoding_order as c_uint,
+      n_latent_vars: meta.per_latent_var.len() as c_uint,
+      latent_vars,
+    };
+  }
+  PcoError::PcoSuccess
+}
+
+/// Reports metadata of the first chunk; for multi-chunk files, walk the file
+/// with a `PcoDecompressor` to reach later chunks, since the standalone
+/// format stores no chunk byte sizes to skip by.
+#[no_mangle]
+pub extern "C" fn pco_inspect(
+  compressed: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  dst: *mut PcoChunkStats,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+
+  macro_rules! match_dtype_inspect {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _inspect::<$t>(src, dst),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_inspect)
+}
+
+/// Trailing magic identifying the optional seek index footer.
+///
+/// The footer sits after the standalone terminator byte, where pco readers
+/// stop, so indexed files stay decodable by any pco implementation. Layout,
+/// all little-endian: one `(u32 byte_offset, u32 cum_n)` entry per chunk,
+/// where `byte_offset` points at the chunk's dtype byte and `cum_n` counts
+/// the numbers in all prior chunks; then the `u32` entry count; then this
+/// magic as the file's last 4 bytes.
+const SEEK_INDEX_MAGIC: [u8; 4] = *b"pidx";
+const SEEK_ENTRY_SIZE: usize = 8;
+
+/// One seek index entry; `byte_offset` can be fed directly to
+/// `pco_decompress_chunks_parallel` as a chunk offset.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct PcoSeekEntry {
+  byte_offset: c_uint,
+  cum_n: c_uint,
+}
+
+fn write_seek_index(dst: &mut Vec<u8>, entries: &[(u32, u32)]) {
+  for &(byte_offset, cum_n) in entries {
+    dst.extend_from_slice(&byte_offset.to_le_bytes());
+    dst.extend_from_slice(&cum_n.to_le_bytes());
+  }
+  dst.extend_from_slice(&(entries.len() as u32).to_le_bytes());
+  dst.extend_from_slice(&SEEK_INDEX_MAGIC);
+}
+
+fn parse_seek_index(src: &[u8]) -> Option<Vec<(u32, u32)>> {
+  if src.len() < SEEK_ENTRY_SIZE || src[src.len() - 4..] != SEEK_INDEX_MAGIC {
+    return None;
+  }
+  let n_bytes = &src[src.len() - 8..src.len() - 4];
+  let n = u32::from_le_bytes(n_bytes.try_into().unwrap()) as usize;
+  let footer_size = SEEK_ENTRY_SIZE * n + 8;
+  if n == 0 || footer_size > src.len() {
+    return None;
+  }
+  let body_size = src.len() - footer_size;
+  let mut entries: Vec<(u32, u32)> = Vec::with_capacity(n);
+  for entry in src[body_size..src.len() - 8].chunks_exact(SEEK_ENTRY_SIZE) {
+    let byte_offset = u32::from_le_bytes(entry[..4].try_into().unwrap());
+    let cum_n = u32::from_le_bytes(entry[4..].try_into().unwrap());
+    // reject footers that don't describe this file: offsets must climb
+    // through the chunk region and the first chunk must hold number 0
+    let consistent = (byte_offset as usize) < body_size
+      && entries.last().map_or(cum_n == 0, |&(prev_offset, prev_n)| {
+        byte_offset > prev_offset && cum_n > prev_n
+      });
+    if !consistent {
+      return None;
+    }
+    entries.push((byte_offset, cum_n));
+  }
+  Some(entries)
+}
+
+/// Matches `standalone::simple_compress` byte for byte, then appends the
+/// seek index footer.
+pub(crate) fn simple_compress_indexed<T: NumberLike>(
+  nums: &[T],
+  config: &ChunkConfig,
+) -> Result<Vec<u8>, PcoError> {
+  let result: pco::errors::PcoResult<(Vec<u8>, Vec<(usize, usize)>)> = (|| {
+    let n_per_chunk = config.paging_spec.n_per_page(nums.len())?;
+    let mut entries = Vec::with_capacity(n_per_chunk.len());
+    let fc = FileCompressor::default().with_n_hint(nums.len());
+    let mut dst = fc.write_header(Vec::new())?;
+    let mut start = 0;
+    let mut this_chunk_config = config.clone();
+    for &chunk_n in &n_per_chunk {
+      entries.push((dst.len(), start));
+      this_chunk_config.paging_spec = PagingSpec::Exact(vec![chunk_n]);
+      let cc = fc.chunk_compressor(
+        &nums[start..start + chunk_n],
+        &this_chunk_config,
+      )?;
+      dst = cc.write_chunk(dst)?;
+      start += chunk_n;
+    }
+    dst = fc.write_footer(dst)?;
+    Ok((dst, entries))
+  })();
+  let (mut dst, entries) = result.map_err(|e| register_err(&e))?;
+  if !entries.is_empty() {
+    // index entries are u32 pairs; a file whose body or count outgrows them
+    // would get a garbage footer that silently disables seeking
+    let entries: Option<Vec<(u32, u32)>> = entries
+      .iter()
+      .map(|&(byte_offset, cum_n)| {
+        Some((
+          u32::try_from(byte_offset).ok()?,
+          u32::try_from(cum_n).ok()?,
+        ))
+      })
+      .collect();
+    let Some(entries) = entries else {
+      return Err(register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "the file is too large for a seek index; compress without enable_seek_index",
+      ));
+    };
+    write_seek_index(&mut dst, &entries);
+  }
+  Ok(dst)
+}
+
+/// Reads the seek index appended by compressing with `enable_seek_index`
+/// set. If `dst` is null, only the entry count is written to `n_entries`;
+/// otherwise up to `dst_capacity` entries are copied out as well. Errors
+/// with `PcoInvalidArgumentError` if the file carries no index.
+#[no_mangle]
+pub extern "C" fn pco_parse_seek_index(
+  compressed: *const c_void,
+  len: c_uint,
+  dst: *mut PcoSeekEntry,
+  dst_capacity: size_t,
+  n_entries: *mut size_t,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let Some(entries) = parse_seek_index(src) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "the file has no seek index",
+    );
+  };
+  unsafe { *n_entries = entries.len() };
+  if dst.is_null() {
+    return PcoError::PcoSuccess;
+  }
+  if dst_capacity < entries.len() {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "dst_capacity is less than the seek index entry count",
+    );
+  }
+  for (i, &(byte_offset, cum_n)) in entries.iter().enumerate() {
+    unsafe {
+      *dst.add(i) = PcoSeekEntry {
+        byte_offset: byte_offset as c_uint,
+        cum_n: cum_n as c_uint,
+      }
+    };
+  }
+  PcoError::PcoSuccess
+}
+
+fn _decompress_range<T: NumberLike>(
+  compressed: *const c_void,
+  len: c_uint,
+  start_idx: c_uint,
+  end_idx: c_uint,
+  dst: *mut c_void,
+  n: *mut c_uint,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let start_idx = start_idx as usize;
+  let end_idx = end_idx as usize;
+  if end_idx < start_idx {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "end_idx must be at least start_idx",
+    );
+  }
+  let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut T, end_idx - start_idx) };
+
+  let result: pco::errors::PcoResult<usize> = (|| {
+    let (fd, mut rest) = FileDecompressor::new(src)?;
+    // The standalone format stores no chunk byte sizes, so chunks before the
+    // range still get decoded (into a small scratch batch, skipping the
+    // output writes); a seek index, when present, instead jumps straight to
+    // the chunk containing start_idx.
+    let mut pos = 0;
+    if let Some(entries) = parse_seek_index(src) {
+      let i = entries.partition_point(|&(_, cum_n)| cum_n as usize <= start_idx);
+      if i > 0 {
+        let (byte_offset, cum_n) = entries[i - 1];
+        rest = &src[byte_offset as usize..];
+        pos = cum_n as usize;
+      }
+    }
+    let mut scratch = [T::default(); FULL_BATCH_N];
+    let mut written = 0;
+    loop {
+      let mut cd = match fd.chunk_decompressor::<T, _>(rest)? {
+        MaybeChunkDecompressor::EndOfData(_) => return Ok(written),
+        MaybeChunkDecompressor::Some(cd) => cd,
+      };
+      let chunk_n = cd.n();
+      let mut chunk_processed = 0;
+      while chunk_processed < chunk_n {
+        if pos >= end_idx {
+          return Ok(written);
+        }
+        let batch_n = FULL_BATCH_N.min(chunk_n - chunk_processed);
+        let progress = cd.decompress(&mut scratch[..batch_n])?;
+        let copy_start = start_idx.clamp(pos, pos + progress.n_processed);
+        let copy_end = end_idx.clamp(pos, pos + progress.n_processed);
+        if copy_end > copy_start {
+          dst[written..written + copy_end - copy_start]
+            .copy_from_slice(&scratch[copy_start - pos..copy_end - pos]);
+          written += copy_end - copy_start;
+        }
+        pos += progress.n_processed;
+        chunk_processed += progress.n_processed;
+      }
+      rest = cd.into_src();
+    }
+  })();
+
+  match result {
+    Err(e) => register_err(&e),
+    Ok(written) => {
+      unsafe { *n = written as c_uint };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompress_range(
+  compressed: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  start_idx: c_uint,
+  end_idx: c_uint,
+  dst: *mut c_void,
+  n: *mut c_uint,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+
+  macro_rules! match_dtype_range {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _decompress_range::<$t>(
+          compressed, len, start_idx, end_idx, dst, n,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_range)
+}
+
+fn _get_nth<T: NumberLike>(
+  compressed: *const c_void,
+  len: c_uint,
+  idx: c_uint,
+  dst: *mut c_void,
+) -> PcoError {
+  let Some(end_idx) = idx.checked_add(1) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "idx exceeds the file's count of numbers",
+    );
+  };
+  let mut n: c_uint = 0;
+  let code = _decompress_range::<T>(compressed, len, idx, end_idx, dst, &mut n);
+  if !matches!(code, PcoError::PcoSuccess) {
+    return code;
+  }
+  if n == 0 {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "idx exceeds the file's count of numbers",
+    );
+  }
+  PcoError::PcoSuccess
+}
+
+/// Decodes the single number at position `idx` into `dst`.
+///
+/// Cost is proportional to the distance from the start of the owning chunk to
+/// `idx`, since the chunk's streams are entropy coded and must be decoded
+/// sequentially; decoding stops at the batch containing `idx` and nothing
+/// after it is touched. Files written with `enable_seek_index` jump straight
+/// to the owning chunk, so point lookups stay bounded by one chunk's size
+/// instead of the whole file's.
+#[no_mangle]
+pub extern "C" fn pco_get_nth(
+  compressed: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  idx: c_uint,
+  dst: *mut c_void,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+
+  macro_rules! match_dtype_nth {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _get_nth::<$t>(compressed, len, idx, dst),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_nth)
+}
+
+fn _decompress_cast<S: NumberLike, D: Copy>(
+  compressed: *const c_void,
+  len: c_uint,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+  convert: impl Fn(&[S], &mut [D]),
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut D, dst_capacity as usize) };
+
+  let (fd, mut rest) = match FileDecompressor::new(src) {
+    Err(e) => return register_err(&e),
+    Ok(x) => x,
+  };
+  let mut scratch = [S::default(); FULL_BATCH_N];
+  let mut written = 0;
+  loop {
+    let mut cd = match fd.chunk_decompressor::<S, _>(rest) {
+      Err(e) => return register_err(&e),
+      Ok(MaybeChunkDecompressor::EndOfData(_)) => break,
+      Ok(MaybeChunkDecompressor::Some(cd)) => cd,
+    };
+    let chunk_n = cd.n();
+    if written + chunk_n > dst.len() {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "dst_capacity is less than the file's count of numbers",
+      );
+    }
+    let mut chunk_processed = 0;
+    while chunk_processed < chunk_n {
+      let batch_n = FULL_BATCH_N.min(chunk_n - chunk_processed);
+      let progress = match cd.decompress(&mut scratch[..batch_n]) {
+        Err(e) => return register_err(&e),
+        Ok(progress) => progress,
+      };
+      // the narrowing happens here, while the wide batch is still cache
+      // resident, so the wide type never touches a full-size buffer
+      let n_processed = progress.n_processed;
+      convert(
+        &scratch[..n_processed],
+        &mut dst[written..written + n_processed],
+      );
+      written += n_processed;
+      chunk_processed += n_processed;
+    }
+    rest = cd.into_src();
+  }
+  unsafe { *n = written as c_uint };
+  PcoError::PcoSuccess
+}
+
+/// Decompresses a file of `src_dtype` numbers into a buffer of the narrower
+/// `dst_dtype`, converting batch-wise during write-out instead of
+/// materializing a full buffer of the wide type first, roughly halving the
+/// memory traffic of a decompress-then-convert pass.
+///
+/// Supported pairs: f64 to f32, i64 to i32, and u64 to u32. Float narrowing
+/// rounds to the nearest f32; integer narrowing truncates, so callers should
+/// only use it on columns whose values are known to fit.
+/// The conversion runs through runtime-dispatched kernels, so one artifact
+/// uses AVX-512 or AVX2 where the machine supports it (see
+/// `pco_cpu_features`).
+#[no_mangle]
+pub extern "C" fn pco_decompress_cast(
+  compressed: *const c_void,
+  len: c_uint,
+  src_dtype: c_uchar,
+  dst_dtype: c_uchar,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+) -> PcoError {
+  let (Some(src_dtype), Some(dst_dtype)) = (
+    CoreDataType::from_byte(src_dtype),
+    CoreDataType::from_byte(dst_dtype),
+  ) else {
+    return PcoError::PcoInvalidType;
+  };
+
+  match (src_dtype, dst_dtype) {
+    (CoreDataType::F64, CoreDataType::F32) => _decompress_cast::<f64, f32>(
+      compressed,
+      len,
+      dst,
+      dst_capacity,
+      n,
+      crate::simd::cast_f64_to_f32,
+    ),
+    (CoreDataType::I64, CoreDataType::I32) => _decompress_cast::<i64, i32>(
+      compressed,
+      len,
+      dst,
+      dst_capacity,
+      n,
+      crate::simd::cast_i64_to_i32,
+    ),
+    (CoreDataType::U64, CoreDataType::U32) => _decompress_cast::<u64, u32>(
+      compressed,
+      len,
+      dst,
+      dst_capacity,
+      n,
+      crate::simd::cast_u64_to_u32,
+    ),
+    _ => register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "unsupported cast; supported pairs are f64->f32, i64->i32, and u64->u32",
+    ),
+  }
+}
+
+fn _max_compressed_size<T: NumberLike>(
+  n: usize,
+  paging_spec: &PagingSpec,
+) -> Result<usize, PcoError> {
+  guarantee::file_size::<T::L>(n, paging_spec).map_err(|e| register_err(&e))
+}
+
+/// Writes a worst-case bound on the compressed byte size of `len` numbers to
+/// `dst`, so output buffers for `pco_simple_compress_into` can be sized up
+/// front. A null `config` uses the default chunk config.
+#[no_mangle]
+pub extern "C" fn pco_max_compressed_size(
+  len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut size_t,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = if config.is_null() {
+    ChunkConfig::default()
+  } else {
+    match ChunkConfig::try_from(unsafe { &*config }) {
+      Ok(config) => config,
+      Err(e) => return e,
+    }
+  };
+
+  macro_rules! match_dtype_size {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _max_compressed_size::<$t>(
+          len as usize, &config.paging_spec,
+        ),)+
+      }
+    }
+  }
+  match with_core_dtypes!(match_dtype_size) {
+    Err(e) => e,
+    Ok(size) => {
+      unsafe { *dst = size };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+fn _simple_compress_into<T: NumberLike>(
+  nums: *const c_void,
+  len: c_uint,
+  config: &ChunkConfig,
+  dst: *mut c_void,
+  dst_capacity: size_t,
+) -> Result<usize, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len as usize) };
+  let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut u8, dst_capacity) };
+  let result: pco::errors::PcoResult<usize> = (|| {
+    // matches standalone::simple_compress, but writes directly into the
+    // caller's buffer
+    let fc = FileCompressor::default().with_n_hint(slice.len());
+    let mut rest = fc.write_header(&mut *dst)?;
+    let mut start = 0;
+    let mut this_chunk_config = config.clone();
+    for &chunk_n in &config.paging_spec.n_per_page(slice.len())? {
+      this_chunk_config.paging_spec = PagingSpec::Exact(vec![chunk_n]);
+      let cc = fc.chunk_compressor(
+        &slice[start..start + chunk_n],
+        &this_chunk_config,
+      )?;
+      rest = cc.write_chunk(rest)?;
+      start += chunk_n;
+    }
+    rest = fc.write_footer(rest)?;
+    Ok(dst_capacity - rest.len())
+  })();
+  result.map_err(|e| match e.kind {
+    // a full caller buffer surfaces as a WriteZero io error; report it as
+    // the invalid argument it is rather than an io failure
+    pco::errors::ErrorKind::Io(std::io::ErrorKind::WriteZero) => register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "dst_capacity is too small for the compressed output",
+    ),
+    _ => register_err(&e),
+  })
+}
+
+/// Like `pco_simple_compress`, but writes into a caller-provided buffer of
+/// `dst_capacity` bytes (see `pco_max_compressed_size`) instead of an
+/// FFI-owned vector, and reports the compressed byte count in
+/// `n_bytes_written`.
+#[no_mangle]
+pub extern "C" fn pco_simple_compress_into(
+  nums: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut c_void,
+  dst_capacity: size_t,
+  n_bytes_written: *mut size_t,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  macro_rules! match_dtype_into {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _simple_compress_into::<$t>(
+          nums, len, &config, dst, dst_capacity,
+        ),)+
+      }
+    }
+  }
+  match with_core_dtypes!(match_dtype_into) {
+    Err(e) => e,
+    Ok(n_bytes) => {
+      unsafe { *n_bytes_written = n_bytes };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+trait DynCompressorState: Send {
+  fn push(&mut self, nums: *const c_void, len: usize) -> PcoError;
+  fn finish(&mut self) -> PcoError;
+  fn take_bytes(&mut self) -> Vec<u8>;
+  fn stats(&self) -> PcoStats;
+}
+
+struct CompressorState<T: NumberLike> {
+  fc: FileCompressor,
+  config: ChunkConfig,
+  /// count of numbers per finished chunk, from the config's paging spec
+  chunk_n: usize,
+  buffer: Vec<T>,
+  out: Vec<u8>,
+  stats: PcoStats,
+}
+
+impl<T: NumberLike> CompressorState<T> {
+  fn write_chunk(&mut self, chunk_n: usize) -> PcoError {
+    let result: pco::errors::PcoResult<()> = (|| {
+      let meta_start = Instant::now();
+      let cc = self
+        .fc
+        .chunk_compressor(&self.buffer[..chunk_n], &self.config)?;
+      let page_start = Instant::now();
+      self.out.reserve(cc.chunk_size_hint());
+      cc.write_chunk(&mut self.out)?;
+      self.stats.meta_nanos += (page_start - meta_start).as_nanos() as u64;
+      self.stats.page_nanos += page_start.elapsed().as_nanos() as u64;
+      self.stats.n_processed += chunk_n as u64;
+      Ok(())
+    })();
+    if let Err(e) = result {
+      return register_err(&e);
+    }
+    self.buffer.drain(..chunk_n);
+    PcoError::PcoSuccess
+  }
+}
+
+impl<T: NumberLike> DynCompressorState for CompressorState<T> {
+  fn push(&mut self, nums: *const c_void, len: usize) -> PcoError {
+    let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len) };
+    self.buffer.extend_from_slice(slice);
+    while self.buffer.len() >= self.chunk_n {
+      let err = self.write_chunk(self.chunk_n);
+      if !matches!(err, PcoError::PcoSuccess) {
+        return err;
+      }
+    }
+    PcoError::PcoSuccess
+  }
+
+  fn finish(&mut self) -> PcoError {
+    if !self.buffer.is_empty() {
+      let err = self.write_chunk(self.buffer.len());
+      if !matches!(err, PcoError::PcoSuccess) {
+        return err;
+      }
+    }
+    if let Err(e) = self.fc.write_footer(&mut self.out) {
+      return register_err(&e);
+    }
+    PcoError::PcoSuccess
+  }
+
+  fn take_bytes(&mut self) -> Vec<u8> {
+    let bytes = std::mem::take(&mut self.out);
+    self.stats.n_bytes += bytes.len() as u64;
+    bytes
+  }
+
+  fn stats(&self) -> PcoStats {
+    self.stats
+  }
+}
+
+/// Opaque handle for incremental, push-style standalone compression.
+///
+/// Numbers pushed in are buffered until a full chunk (per the config's
+/// paging spec) accumulates, at which point it is compressed; finished bytes
+/// can be pulled out at any time, so compression can overlap with ingestion
+/// without the caller materializing the whole column first.
+pub struct PcoCompressor {
+  state: Box<dyn DynCompressorState>,
+}
+
+#[no_mangle]
+pub extern "C" fn pco_compressor_new(
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut *mut PcoCompressor,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+  // push streams have no known total count, so only equal paging makes sense
+  let chunk_n = match &config.paging_spec {
+    PagingSpec::EqualPagesUpTo(n) if *n > 0 => *n,
+    _ => {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "pco_compressor_new requires equal paging: exact_page_ns must be null and max_page_n > 0",
+      )
+    }
+  };
+
+  fn make_state<T: NumberLike>(
+    config: ChunkConfig,
+    chunk_n: usize,
+  ) -> Result<Box<dyn DynCompressorState>, PcoError> {
+    let fc = FileCompressor::default();
+    let mut out = Vec::new();
+    if let Err(e) = fc.write_header(&mut out) {
+      return Err(register_err(&e));
+    }
+    Ok(Box::new(CompressorState::<T> {
+      fc,
+      config,
+      chunk_n,
+      buffer: Vec::new(),
+      out,
+      stats: PcoStats::default(),
+    }))
+  }
+
+  macro_rules! match_dtype_state {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => make_state::<$t>(config, chunk_n),)+
+      }
+    }
+  }
+  let state = match with_core_dtypes!(match_dtype_state) {
+    Ok(state) => state,
+    Err(e) => return e,
+  };
+
+  unsafe { *dst = Box::into_raw(Box::new(PcoCompressor { state })) };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_compressor_push(
+  compressor: *mut PcoCompressor,
+  nums: *const c_void,
+  len: c_uint,
+) -> PcoError {
+  let compressor = unsafe { &mut *compressor };
+  compressor.state.push(nums, len as usize)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_compressor_pull(
+  compressor: *mut PcoCompressor,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let compressor = unsafe { &mut *compressor };
+  let bytes = compressor.state.take_bytes();
+  unsafe { (*dst).init_from_vec(bytes) };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_compressor_finish(
+  compressor: *mut PcoCompressor,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let compressor = unsafe { &mut *compressor };
+  let err = compressor.state.finish();
+  if !matches!(err, PcoError::PcoSuccess) {
+    return err;
+  }
+  let bytes = compressor.state.take_bytes();
+  unsafe { (*dst).init_from_vec(bytes) };
+  PcoError::PcoSuccess
+}
+
+/// Copies the handle's accumulated performance counters to `dst`. For a
+/// compressor, metadata time covers mode/delta detection and bin
+/// optimization per chunk and page time covers chunk serialization.
+#[no_mangle]
+pub extern "C" fn pco_compressor_stats(
+  compressor: *const PcoCompressor,
+  dst: *mut PcoStats,
+) -> PcoError {
+  let compressor = unsafe { &*compressor };
+  unsafe { *dst = compressor.state.stats() };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_compressor_free(compressor: *mut PcoCompressor) -> PcoError {
+  drop(unsafe { Box::from_raw(compressor) });
+  PcoError::PcoSuccess
+}
+
+fn resolve_n_threads(n_threads: c_uint) -> usize {
+  if n_threads == 0 {
+    thread::available_parallelism()
+      .map(|p| p.get())
+      .unwrap_or(1)
+  } else {
+    n_threads as usize
+  }
+}
+
+fn _compress_parallel<T: NumberLike>(
+  nums: *const c_void,
+  len: c_uint,
+  config: &ChunkConfig,
+  n_threads: c_uint,
+  ffi_vec_ptr: *mut PcoFfiVec,
+) -> PcoError {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len as usize) };
+
+  // like standalone::simple_compress, we use the paging spec to decide chunk
+  // boundaries, but here each chunk is an independent unit of work
+  let n_per_chunk = match config.paging_spec.n_per_page(slice.len()) {
+    Ok(n_per_chunk) => n_per_chunk,
+    Err(e) => return register_err(&e),
+  };
+  let mut chunk_slices = Vec::with_capacity(n_per_chunk.len());
+  let mut start = 0;
+  for &chunk_n in &n_per_chunk {
+    chunk_slices.push(&slice[start..start + chunk_n]);
+    start += chunk_n;
+  }
+
+  let fc = FileCompressor::default().with_n_hint(slice.len());
+  let n_threads = resolve_n_threads(n_threads).clamp(1, chunk_slices.len().max(1));
+  let mut chunk_bytes = vec![Vec::new(); chunk_slices.len()];
+  // worker threads park the first pco error here so the calling thread can
+  // register it (the last error message is thread-local)
+  let failed = Mutex::new(None);
+
+  let compress_chunk = |chunk_nums: &[T], dst: &mut Vec<u8>| -> pco::errors::PcoResult<()> {
+    let cc = fc.chunk_compressor(chunk_nums, config)?;
+    dst.reserve(cc.chunk_size_hint());
+    cc.write_chunk(dst)?;
+    Ok(())
+  };
+
+  thread::scope(|scope| {
+    // deal each chunk's dst out round robin; chunk sizes are roughly equal,
+    // so this balances well enough without a work queue
+    let mut worker_dsts: Vec<Vec<(usize, &mut Vec<u8>)>> =
+      (0..n_threads).map(|_| Vec::new()).collect();
+    for (chunk_idx, dst) in chunk_bytes.iter_mut().enumerate() {
+      worker_dsts[chunk_idx % n_threads].push((chunk_idx, dst));
+    }
+
+    for dsts in worker_dsts {
+      let chunk_slices = &chunk_slices;
+      let failed = &failed;
+      let compress_chunk = &compress_chunk;
+      scope.spawn(move || {
+        for (chunk_idx, dst) in dsts {
+          if failed.lock().unwrap().is_some() {
+            return;
+          }
+          if let Err(e) = compress_chunk(chunk_slices[chunk_idx], dst) {
+            failed.lock().unwrap().get_or_insert(e);
+            return;
+          }
+        }
+      });
+    }
+  });
+
+  if let Some(e) = failed.into_inner().unwrap() {
+    return register_err(&e);
+  }
+
+  let mut res = Vec::with_capacity(chunk_bytes.iter().map(|b| b.len()).sum::<usize>() + 16);
+  if let Err(e) = fc.write_header(&mut res) {
+    return register_err(&e);
+  }
+  for bytes in &chunk_bytes {
+    res.extend_from_slice(bytes);
+  }
+  if let Err(e) = fc.write_footer(&mut res) {
+    return register_err(&e);
+  }
+
+  unsafe { (*ffi_vec_ptr).init_from_vec(res) };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_compress_parallel(
+  nums: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  n_threads: c_uint,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  macro_rules! match_dtype_parallel {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _compress_parallel::<$t>(
+          nums, len, &config, n_threads, dst,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_parallel)
+}
+
+/// One column of a batch compression call.
+#[repr(C)]
+pub struct PcoArray {
+  pub(crate) nums: *const c_void,
+  pub(crate) len: c_uint,
+  pub(crate) dtype: c_uchar,
+}
+
+// the caller guarantees each array's pointer stays valid for the call, and
+// workers only read through it
+unsafe impl Sync for PcoArray {}
+
+fn _compress_array(
+  array: &PcoArray,
+  dtype: CoreDataType,
+  config: &ChunkConfig,
+) -> pco::errors::PcoResult<Vec<u8>> {
+  fn compress_one<T: NumberLike>(
+    nums: *const c_void,
+    len: usize,
+    config: &ChunkConfig,
+  ) -> pco::errors::PcoResult<Vec<u8>> {
+    let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len) };
+    pco::standalone::simple_compress(slice, config)
+  }
+
+  macro_rules! match_dtype_array {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => compress_one::<$t>(
+          array.nums, array.len as usize, config,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_array)
+}
+
+/// Compresses `n_arrays` columns in one FFI crossing, writing one standalone
+/// file per column into `dsts`. The columns may have different data types.
+/// Work fans out over `n_threads` threads (0 means all available cores); a
+/// null `config` uses the default chunk config. On error, no `dsts` entries
+/// are initialized.
+#[no_mangle]
+pub extern "C" fn pco_compress_batch(
+  arrays: *const PcoArray,
+  n_arrays: size_t,
+  config: *const PcoChunkConfig,
+  n_threads: c_uint,
+  dsts: *mut PcoFfiVec,
+) -> PcoError {
+  let arrays = unsafe { std::slice::from_raw_parts(arrays, n_arrays) };
+  let config = if config.is_null() {
+    ChunkConfig::default()
+  } else {
+    match ChunkConfig::try_from(unsafe { &*config }) {
+      Ok(config) => config,
+      Err(e) => return e,
+    }
+  };
+
+  // validate every dtype before spawning any work
+  let mut dtypes = Vec::with_capacity(arrays.len());
+  for array in arrays {
+    let Some(dtype) = CoreDataType::from_byte(array.dtype) else {
+      return PcoError::PcoInvalidType;
+    };
+    dtypes.push(dtype);
+  }
+
+  let n_threads = resolve_n_threads(n_threads).clamp(1, arrays.len().max(1));
+  let mut array_bytes = vec![Vec::new(); arrays.len()];
+  let failed = Mutex::new(None);
+
+  thread::scope(|scope| {
+    let mut worker_dsts: Vec<Vec<(usize, &mut Vec<u8>)>> =
+      (0..n_threads).map(|_| Vec::new()).collect();
+    for (array_idx, dst) in array_bytes.iter_mut().enumerate() {
+      worker_dsts[array_idx % n_threads].push((array_idx, dst));
+    }
+
+    for dsts in worker_dsts {
+      let dtypes = &dtypes;
+      let config = &config;
+      let failed = &failed;
+      scope.spawn(move || {
+        for (array_idx, dst) in dsts {
+          if failed.lock().unwrap().is_some() {
+            return;
+          }
+          match _compress_array(&arrays[array_idx], dtypes[array_idx], config) {
+            Ok(bytes) => *dst = bytes,
+            Err(e) => {
+              failed.lock().unwrap().get_or_insert(e);
+              return;
+            }
+          }
+        }
+      });
+    }
+  });
+
+  if let Some(e) = failed.into_inner().unwrap() {
+    return register_err(&e);
+  }
+
+  for (array_idx, bytes) in array_bytes.into_iter().enumerate() {
+    unsafe { (*dsts.add(array_idx)).init_from_vec(bytes) };
+  }
+  PcoError::PcoSuccess
+}
+
+fn _decompress_chunks_parallel<T: NumberLike>(
+  compressed: *const c_void,
+  len: c_uint,
+  chunk_offsets: *const c_uint,
+  n_chunks: c_uint,
+  n_threads: c_uint,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let offsets = unsafe { std::slice::from_raw_parts(chunk_offsets, n_chunks as usize) };
+
+  let fd = match FileDecompressor::new(src) {
+    Err(e) => return register_err(&e),
+    Ok((fd, _)) => fd,
+  };
+
+  // first pass: read each chunk's element count so every chunk gets a
+  // disjoint destination slice
+  let mut chunk_ns = Vec::with_capacity(offsets.len());
+  for &offset in offsets {
+    if offset as usize >= src.len() {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "chunk offset exceeds the compressed length",
+      );
+    }
+    match fd.chunk_decompressor::<T, _>(&src[offset as usize..]) {
+      Err(e) => return register_err(&e),
+      Ok(MaybeChunkDecompressor::EndOfData(_)) => {
+        return register_local_err(
+          PcoError::PcoInvalidArgumentError,
+          "chunk offset points at the file terminator",
+        )
+      }
+      Ok(MaybeChunkDecompressor::Some(cd)) => chunk_ns.push(cd.n()),
+    }
+  }
+  let total_n: usize = chunk_ns.iter().sum();
+  unsafe { *n = total_n as c_uint };
+  if (dst_capacity as usize) < total_n {
+    // the caller can learn the necessary capacity from *n and retry
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "dst_capacity is less than the total count of numbers",
+    );
+  }
+
+  let mut dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut T, total_n) };
+  let mut chunk_dsts = Vec::with_capacity(chunk_ns.len());
+  for &chunk_n in &chunk_ns {
+    let (chunk_dst, rest) = dst.split_at_mut(chunk_n);
+    chunk_dsts.push(chunk_dst);
+    dst = rest;
+  }
+
+  let n_threads = resolve_n_threads(n_threads).clamp(1, chunk_dsts.len().max(1));
+  let failed = Mutex::new(None);
+
+  let decompress_chunk = |offset: usize, chunk_dst: &mut [T]| -> pco::errors::PcoResult<()> {
+    match fd.chunk_decompressor::<T, _>(&src[offset..])? {
+      MaybeChunkDecompressor::EndOfData(_) => unreachable!("checked in first pass"),
+      MaybeChunkDecompressor::Some(mut cd) => {
+        cd.decompress(chunk_dst)?;
+        Ok(())
+      }
+    }
+  };
+
+  thread::scope(|scope| {
+    let mut worker_dsts: Vec<Vec<(usize, &mut [T])>> = (0..n_threads).map(|_| Vec::new()).collect();
+    for (chunk_idx, chunk_dst) in chunk_dsts.into_iter().enumerate() {
+      worker_dsts[chunk_idx % n_threads].push((chunk_idx, chunk_dst));
+    }
+
+    for dsts in worker_dsts {
+      let failed = &failed;
+      let decompress_chunk = &decompress_chunk;
+      scope.spawn(move || {
+        for (chunk_idx, chunk_dst) in dsts {
+          if failed.lock().unwrap().is_some() {
+            return;
+          }
+          if let Err(e) = decompress_chunk(offsets[chunk_idx] as usize, chunk_dst) {
+            failed.lock().unwrap().get_or_insert(e);
+            return;
+          }
+        }
+      });
+    }
+  });
+
+  // register on the calling thread so pco_last_error_message sees it
+  match failed.into_inner().unwrap() {
+    Some(e) => register_err(&e),
+    None => PcoError::PcoSuccess,
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompress_chunks_parallel(
+  compressed: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  chunk_offsets: *const c_uint,
+  n_chunks: c_uint,
+  n_threads: c_uint,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+
+  macro_rules! match_dtype_parallel {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _decompress_chunks_parallel::<$t>(
+          compressed, len, chunk_offsets, n_chunks, n_threads, dst, dst_capacity, n,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_parallel)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompressor_new(
+  header_src: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  dst: *mut *mut PcoDecompressor,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let slice = unsafe { std::slice::from_raw_parts(header_src as *const u8, len as usize) };
+  match FileDecompressor::new(slice) {
+    Err(e) => register_err(&e),
+    Ok((fd, rest)) => {
+      unsafe {
+        *n_bytes_read = (slice.len() - rest.len()) as c_uint;
+        *dst = Box::into_raw(Box::new(PcoDecompressor {
+          inner: fd,
+          dtype,
+          stats: Cell::new(PcoStats::default()),
+          deadline: Cell::new(None),
+          cancel_fn: Cell::new(None),
+          cancel_user_data: Cell::new(std::ptr::null_mut()),
+          pending: Cell::new(None),
+        }));
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompressor_n_hint(
+  decompressor: *const PcoDecompressor,
+  dst: *mut c_uint,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  unsafe { *dst = decompressor.inner.n_hint() as c_uint };
+  PcoError::PcoSuccess
+}
+
+fn _peek_chunk_n<T: NumberLike>(fd: &FileDecompressor, src: &[u8], dst: *mut c_uint) -> PcoError {
+  match fd.chunk_decompressor::<T, _>(src) {
+    Err(e) => register_err(&e),
+    Ok(MaybeChunkDecompressor::EndOfData(_)) => {
+      unsafe { *dst = 0 };
+      PcoError::PcoSuccess
+    }
+    Ok(MaybeChunkDecompressor::Some(cd)) => {
+      unsafe { *dst = cd.n() as c_uint };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+fn _decompress_chunk<T: NumberLike>(
+  decompressor: &PcoDecompressor,
+  src: &[u8],
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let stats = &decompressor.stats;
+  let meta_start = Instant::now();
+  match decompressor.inner.chunk_decompressor::<T, _>(src) {
+    Err(e) => register_err(&e),
+    Ok(MaybeChunkDecompressor::EndOfData(rest)) => {
+      unsafe {
+        *n = 0;
+        *n_bytes_read = (src.len() - rest.len()) as c_uint;
+      }
+      PcoError::PcoSuccess
+    }
+    Ok(MaybeChunkDecompressor::Some(mut cd)) => {
+      let page_start = Instant::now();
+      let chunk_n = cd.n();
+      unsafe { *n = chunk_n as c_uint };
+      if (dst_capacity as usize) < chunk_n {
+        // the caller can learn the necessary capacity from *n and retry
+        return register_local_err(
+          PcoError::PcoInvalidArgumentError,
+          "dst_capacity is less than the chunk's count of numbers",
+        );
+      }
+      let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut T, chunk_n) };
+      if decompressor.is_interruptible() {
+        // decode batch by batch so a deadline or cancellation takes effect
+        // mid-chunk instead of after hundreds of milliseconds
+        let mut written = 0;
+        while written < chunk_n {
+          if let Some(code) = decompressor.check_interrupt() {
+            return code;
+          }
+          let batch_n = FULL_BATCH_N.min(chunk_n - written);
+          match cd.decompress(&mut dst[written..written + batch_n]) {
+            Err(e) => return register_err(&e),
+            Ok(progress) => written += progress.n_processed,
+          }
+        }
+      } else if let Err(e) = cd.decompress(dst) {
+        return register_err(&e);
+      }
+      let chunk_bytes = src.len() - cd.into_src().len();
+      unsafe { *n_bytes_read = chunk_bytes as c_uint };
+      let mut new_stats = stats.get();
+      new_stats.meta_nanos += (page_start - meta_start).as_nanos() as u64;
+      new_stats.page_nanos += page_start.elapsed().as_nanos() as u64;
+      new_stats.n_processed += chunk_n as u64;
+      new_stats.n_bytes += chunk_bytes as u64;
+      stats.set(new_stats);
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompressor_peek_chunk_n(
+  decompressor: *const PcoDecompressor,
+  src: *const c_void,
+  len: c_uint,
+  dst: *mut c_uint,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  let slice = unsafe { std::slice::from_raw_parts(src as *const u8, len as usize) };
+
+  macro_rules! match_dtype_peek {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match decompressor.dtype {
+        $(CoreDataType::$name => _peek_chunk_n::<$t>(&decompressor.inner, slice, dst),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_peek)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_decompressor_decompress_chunk(
+  decompressor: *const PcoDecompressor,
+  src: *const c_void,
+  len: c_uint,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+  n: *mut c_uint,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  let slice = unsafe { std::slice::from_raw_parts(src as *const u8, len as usize) };
+
+  macro_rules! match_dtype_chunk {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match decompressor.dtype {
+        $(CoreDataType::$name => _decompress_chunk::<$t>(
+          decompressor, slice, dst, dst_capacity, n, n_bytes_read,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_chunk)
+}
+
+fn _decompress_chunk_async<T: NumberLike>(
+  decompressor: &PcoDecompressor,
+  src_addr: usize,
+  src_len: usize,
+  dst_addr: usize,
+  dst_capacity: usize,
+) -> PcoError {
+  let fd = decompressor.inner.clone();
+  let handle = thread::spawn(move || {
+    let src = unsafe { std::slice::from_raw_parts(src_addr as *const u8, src_len) };
+    let meta_start = Instant::now();
+    match fd.chunk_decompressor::<T, _>(src) {
+      Err(e) => AsyncOutcome::Failed(e),
+      Ok(MaybeChunkDecompressor::EndOfData(rest)) => AsyncOutcome::Done {
+        n: 0,
+        n_bytes_read: src.len() - rest.len(),
+        meta_nanos: 0,
+        page_nanos: 0,
+      },
+      Ok(MaybeChunkDecompressor::Some(mut cd)) => {
+        let page_start = Instant::now();
+        let chunk_n = cd.n();
+        if dst_capacity < chunk_n {
+          return AsyncOutcome::Capacity { chunk_n };
+        }
+        let dst = unsafe { std::slice::from_raw_parts_mut(dst_addr as *mut T, chunk_n) };
+        if let Err(e) = cd.decompress(dst) {
+          return AsyncOutcome::Failed(e);
+        }
+        AsyncOutcome::Done {
+          n: chunk_n,
+          n_bytes_read: src.len() - cd.into_src().len(),
+          meta_nanos: (page_start - meta_start).as_nanos() as u64,
+          page_nanos: page_start.elapsed().as_nanos() as u64,
+        }
+      }
+    }
+  });
+  decompressor.pending.set(Some(handle));
+  PcoError::PcoSuccess
+}
+
+/// Starts decoding the next chunk on a worker thread and returns immediately,
+/// so the caller can process the previous chunk while this one decodes — a
+/// 2-deep pipeline that hides decode latency behind the consumer's work.
+///
+/// `src` and `dst` must stay valid and untouched until
+/// `pco_decompressor_await_chunk` returns, and the handle must not be used
+/// for anything else in between; at most one decode may be in flight per
+/// handle. The worker does not poll the handle's deadline or cancel callback.
+#[no_mangle]
+pub extern "C" fn pco_decompressor_decompress_chunk_async(
+  decompressor: *const PcoDecompressor,
+  src: *const c_void,
+  len: c_uint,
+  dst: *mut c_void,
+  dst_capacity: c_uint,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  if let Some(pending) = decompressor.pending.take() {
+    decompressor.pending.set(Some(pending));
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "an async decode is already in flight",
+    );
+  }
+
+  macro_rules! match_dtype_async {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match decompressor.dtype {
+        $(CoreDataType::$name => _decompress_chunk_async::<$t>(
+          decompressor, src as usize, len as usize, dst as usize, dst_capacity as usize,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_async)
+}
+
+/// Blocks until the decode started by `pco_decompressor_decompress_chunk_async`
+/// finishes, then reports its chunk count and bytes read exactly as the
+/// synchronous call would have.
+#[no_mangle]
+pub extern "C" fn pco_decompressor_await_chunk(
+  decompressor: *const PcoDecompressor,
+  n: *mut c_uint,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  let Some(handle) = decompressor.pending.take() else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "no async decode is in flight",
+    );
+  };
+  match handle.join() {
+    Err(_) => register_local_err(
+      PcoError::PcoDecompressionError,
+      "the async decode worker panicked",
+    ),
+    Ok(AsyncOutcome::Failed(e)) => register_err(&e),
+    Ok(AsyncOutcome::Capacity { chunk_n }) => {
+      // the caller can learn the necessary capacity from *n and retry
+      unsafe { *n = chunk_n as c_uint };
+      register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "dst_capacity is less than the chunk's count of numbers",
+      )
+    }
+    Ok(AsyncOutcome::Done {
+      n: chunk_n,
+      n_bytes_read: chunk_bytes,
+      meta_nanos,
+      page_nanos,
+    }) => {
+      unsafe {
+        *n = chunk_n as c_uint;
+        *n_bytes_read = chunk_bytes as c_uint;
+      }
+      let mut new_stats = decompressor.stats.get();
+      new_stats.meta_nanos += meta_nanos;
+      new_stats.page_nanos += page_nanos;
+      new_stats.n_processed += chunk_n as u64;
+      new_stats.n_bytes += chunk_bytes as u64;
+      decompressor.stats.set(new_stats);
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+/// Gives the handle `deadline_nanos` nanoseconds from now; decompress calls
+/// past the deadline fail with `PcoCancelledError` at the next batch
+/// boundary, reclaiming the CPU for live queries. Passing 0 clears the
+/// deadline.
+#[no_mangle]
+pub extern "C" fn pco_decompressor_set_deadline(
+  decompressor: *const PcoDecompressor,
+  deadline_nanos: u64,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  let deadline = if deadline_nanos == 0 {
+    None
+  } else {
+    Some(Instant::now() + std::time::Duration::from_nanos(deadline_nanos))
+  };
+  decompressor.deadline.set(deadline);
+  PcoError::PcoSuccess
+}
+
+/// Registers a callback polled at batch boundaries during decompression; a
+/// nonzero return fails the call with `PcoCancelledError`. Passing null
+/// clears the callback.
+#[no_mangle]
+pub extern "C" fn pco_decompressor_set_cancel(
+  decompressor: *const PcoDecompressor,
+  cancel_fn: PcoCancelFn,
+  user_data: *mut c_void,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  decompressor.cancel_fn.set(cancel_fn);
+  decompressor.cancel_user_data.set(user_data);
+  PcoError::PcoSuccess
+}
+
+/// Copies the handle's accumulated performance counters to `dst`. For a
+/// decompressor, metadata time covers chunk meta parsing and ANS table
+/// setup and page time covers page decoding.
+#[no_mangle]
+pub extern "C" fn pco_decompressor_stats(
+  decompressor: *const PcoDecompressor,
+  dst: *mut PcoStats,
+) -> PcoError {
+  let decompressor = unsafe { &*decompressor };
+  unsafe { *dst = decompressor.stats.get() };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_decompressor_free(decompressor: *mut PcoDecompressor) -> PcoError {
+  drop(unsafe { Box::from_raw(decompressor) });
+  PcoError::PcoSuccess
+}
+
+const MULTI_MAGIC: [u8; 4] = *b"pcol";
+const MULTI_FOOTER_FIXED_SIZE: usize = 12;
+
+/// Returns (n_columns, n_rows, dtype bytes) if `src` ends with a valid column
+/// group footer.
+fn parse_multi_footer(src: &[u8]) -> Option<(usize, usize, &[u8])> {
+  if src.len() < MULTI_FOOTER_FIXED_SIZE || src[src.len() - 4..] != MULTI_MAGIC {
+    return None;
+  }
+  let read_u32 = |end: usize| {
+    let mut bytes = [0; 4];
+    bytes.copy_from_slice(&src[end - 4..end]);
+    u32::from_le_bytes(bytes) as usize
+  };
+  let n_columns = read_u32(src.len() - 4);
+  let n_rows = read_u32(src.len() - 8);
+  if n_columns == 0 || src.len() < MULTI_FOOTER_FIXED_SIZE + n_columns {
+    return None;
+  }
+  let dtypes_end = src.len() - MULTI_FOOTER_FIXED_SIZE;
+  Some((
+    n_columns,
+    n_rows,
+    &src[dtypes_end - n_columns..dtypes_end],
+  ))
+}
+
+fn _multi_compress_chunk<T: NumberLike>(
+  fc: &FileCompressor,
+  nums: *const c_void,
+  start: usize,
+  chunk_n: usize,
+  config: &ChunkConfig,
+  dst: Vec<u8>,
+) -> pco::errors::PcoResult<Vec<u8>> {
+  let slice = unsafe { std::slice::from_raw_parts((nums as *const T).add(start), chunk_n) };
+  let cc = fc.chunk_compressor(slice, config)?;
+  cc.write_chunk(dst)
+}
+
+/// Compresses `n_columns` equal-length columns into one container whose
+/// chunks are interleaved row-group style: each row group holds one chunk per
+/// column, in column order, so reading a row range touches one contiguous
+/// byte range instead of one file per column. Row group boundaries follow the
+/// config's paging spec, the same way `pco_simple_compress` splits chunks.
+///
+/// The body is a plain standalone file (every chunk carries its own dtype
+/// byte) followed by a footer after the terminator recording the column
+/// count, row count, and per-column dtypes; standalone readers that walk
+/// chunks ignore the footer.
+#[no_mangle]
+pub extern "C" fn pco_multi_compress(
+  columns: *const PcoArray,
+  n_columns: size_t,
+  config: *const PcoChunkConfig,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let columns = unsafe { std::slice::from_raw_parts(columns, n_columns) };
+  if columns.is_empty() {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "n_columns must be positive",
+    );
+  }
+  let n_rows = columns[0].len as usize;
+  if columns.iter().any(|col| col.len as usize != n_rows) {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "all columns must have the same length",
+    );
+  }
+  let mut dtypes = Vec::with_capacity(columns.len());
+  for col in columns {
+    let Some(dtype) = CoreDataType::from_byte(col.dtype) else {
+      return PcoError::PcoInvalidType;
+    };
+    dtypes.push(dtype);
+  }
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  let result: pco::errors::PcoResult<Vec<u8>> = (|| {
+    let row_groups = config.paging_spec.n_per_page(n_rows)?;
+    let fc = FileCompressor::default().with_n_hint(n_rows * columns.len());
+    let mut dst_vec = fc.write_header(Vec::new())?;
+    let mut this_chunk_config = config.clone();
+    let mut start = 0;
+    for &group_n in &row_groups {
+      this_chunk_config.paging_spec = PagingSpec::Exact(vec![group_n]);
+      for (col, &dtype) in columns.iter().zip(&dtypes) {
+        macro_rules! match_dtype_multi {
+          {$($name:ident($lname:ident) => $t:ty,)+} => {
+            match dtype {
+              $(CoreDataType::$name => {
+                dst_vec = _multi_compress_chunk::<$t>(
+                  &fc, col.nums, start, group_n, &this_chunk_config, dst_vec,
+                )?;
+              })+
+            }
+          }
+        }
+        with_core_dtypes!(match_dtype_multi);
+      }
+      start += group_n;
+    }
+    let mut dst_vec = fc.write_footer(dst_vec)?;
+    for col in columns {
+      dst_vec.push(col.dtype);
+    }
+    dst_vec.extend((n_rows as u32).to_le_bytes());
+    dst_vec.extend((columns.len() as u32).to_le_bytes());
+    dst_vec.extend(MULTI_MAGIC);
+    Ok(dst_vec)
+  })();
+  match result {
+    Err(e) => register_err(&e),
+    Ok(v) => {
+      unsafe { (*dst).init_from_vec(v) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+/// Reads a column group file's column count, row count, and per-column dtype
+/// bytes without decoding anything. A null `dtypes` skips the dtype copy, so
+/// a first call can learn the column count and a second can fetch the dtypes.
+#[no_mangle]
+pub extern "C" fn pco_multi_inspect(
+  compressed: *const c_void,
+  len: c_uint,
+  dtypes: *mut c_uchar,
+  dtypes_capacity: size_t,
+  n_columns: *mut size_t,
+  n_rows: *mut c_uint,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let Some((nc, nr, dtype_bytes)) = parse_multi_footer(src) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "the file has no column group footer",
+    );
+  };
+  unsafe {
+    *n_columns = nc;
+    *n_rows = nr as c_uint;
+  }
+  if !dtypes.is_null() {
+    if dtypes_capacity < nc {
+      return register_local_err(
+        PcoError::PcoInvalidArgumentError,
+        "dtypes_capacity is less than the column count",
+      );
+    }
+    unsafe { std::ptr::copy_nonoverlapping(dtype_bytes.as_ptr(), dtypes, nc) };
+  }
+  PcoError::PcoSuccess
+}
+
+fn _multi_decompress_chunk<'a, T: NumberLike>(
+  fd: &FileDecompressor,
+  src: &'a [u8],
+  dst: *mut c_void,
+  offset: usize,
+  max_n: usize,
+) -> Result<Option<(usize, &'a [u8])>, PcoError> {
+  match fd
+    .chunk_decompressor::<T, _>(src)
+    .map_err(|e| register_err(&e))?
+  {
+    MaybeChunkDecompressor::EndOfData(_) => Ok(None),
+    MaybeChunkDecompressor::Some(mut cd) => {
+      let chunk_n = cd.n();
+      // checked before any write: a corrupted file must not write past the
+      // row count its footer promised, which is all the caller buffered for
+      if chunk_n > max_n {
+        return Err(register_local_err(
+          PcoError::PcoCorruptionError,
+          "the file holds more rows than its footer claims",
+        ));
+      }
+      let dst = unsafe { std::slice::from_raw_parts_mut((dst as *mut T).add(offset), chunk_n) };
+      cd.decompress(dst).map_err(|e| register_err(&e))?;
+      Ok(Some((chunk_n, cd.into_src())))
+    }
+  }
+}
+
+/// Decompresses every column of a `pco_multi_compress` file in one sequential
+/// pass, writing column `c` into `dsts[c]` (each with room for the file's row
+/// count, reported in `n_rows` even on capacity errors). `n_columns` must
+/// match the file's column count.
+#[no_mangle]
+pub extern "C" fn pco_multi_decompress(
+  compressed: *const c_void,
+  len: c_uint,
+  dsts: *const *mut c_void,
+  n_columns: size_t,
+  dst_capacity: c_uint,
+  n_rows: *mut c_uint,
+) -> PcoError {
+  let src = unsafe { std::slice::from_raw_parts(compressed as *const u8, len as usize) };
+  let Some((nc, nr, dtype_bytes)) = parse_multi_footer(src) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "the file has no column group footer",
+    );
+  };
+  unsafe { *n_rows = nr as c_uint };
+  if n_columns != nc {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "n_columns does not match the file's column count",
+    );
+  }
+  if (dst_capacity as usize) < nr {
+    // the caller can learn the necessary capacity from *n_rows and retry
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "dst_capacity is less than the file's row count",
+    );
+  }
+  let dsts = unsafe { std::slice::from_raw_parts(dsts, nc) };
+  let mut dtypes = Vec::with_capacity(nc);
+  for &byte in dtype_bytes {
+    let Some(dtype) = CoreDataType::from_byte(byte) else {
+      return register_local_err(
+        PcoError::PcoCorruptionError,
+        "the column group footer has an invalid dtype",
+      );
+    };
+    dtypes.push(dtype);
+  }
+
+  let (fd, mut rest) = match FileDecompressor::new(src) {
+    Err(e) => return register_err(&e),
+    Ok(pair) => pair,
+  };
+  let mut row_pos = 0;
+  'row_groups: loop {
+    let mut group_n = 0;
+    for (c, (&dst, &dtype)) in dsts.iter().zip(&dtypes).enumerate() {
+      macro_rules! match_dtype_multi {
+        {$($name:ident($lname:ident) => $t:ty,)+} => {
+          match dtype {
+            $(CoreDataType::$name => {
+              _multi_decompress_chunk::<$t>(&fd, rest, dst, row_pos, nr - row_pos)
+            })+
+          }
+        }
+      }
+      match with_core_dtypes!(match_dtype_multi) {
+        Err(e) => return e,
+        Ok(None) if c == 0 => break 'row_groups,
+        Ok(None) => {
+          return register_local_err(
+            PcoError::PcoCorruptionError,
+            "the file ended in the middle of a row group",
+          )
+        }
+        Ok(Some((chunk_n, new_rest))) => {
+          if c == 0 {
+            group_n = chunk_n;
+          } else if chunk_n != group_n {
+            return register_local_err(
+              PcoError::PcoCorruptionError,
+              "columns disagree on the row group's length",
+            );
+          }
+          rest = new_rest;
+        }
+      }
+    }
+    row_pos += group_n;
+  }
+  unsafe { *n_rows = row_pos as c_uint };
+  PcoError::PcoSuccess
+}
@@ -0,0 +1,496 @@
+use libc::{c_uchar, c_uint, c_void, size_t};
+
+use pco::data_types::{CoreDataType, Latent, NumberLike};
+use pco::wrapped::{ChunkCompressor, ChunkDecompressor, FileCompressor, FileDecompressor};
+use pco::{with_core_dtypes, with_core_latents, ChunkConfig, PagingSpec};
+
+use crate::standalone::PcoArray;
+use crate::{register_err, register_local_err, PcoChunkConfig, PcoError, PcoFfiVec, PcoProgress};
+
+/// Opaque handle wrapping `pco::wrapped::FileCompressor`.
+pub struct PcoWrappedFc {
+  inner: FileCompressor,
+}
+
+enum DynCc {
+  U16(ChunkCompressor<u16>),
+  U32(ChunkCompressor<u32>),
+  U64(ChunkCompressor<u64>),
+}
+
+/// Opaque handle wrapping `pco::wrapped::ChunkCompressor`.
+pub struct PcoWrappedCc(DynCc);
+
+/// Opaque handle wrapping `pco::wrapped::FileDecompressor`.
+pub struct PcoWrappedFd {
+  inner: FileDecompressor,
+}
+
+macro_rules! impl_dyn_cd {
+  {$($name:ident($lname:ident) => $t:ty,)+} => {
+    enum DynCd {
+      $($name(ChunkDecompressor<$t>),)+
+    }
+  }
+}
+with_core_dtypes!(impl_dyn_cd);
+
+/// Opaque handle wrapping `pco::wrapped::ChunkDecompressor`.
+pub struct PcoWrappedCd {
+  inner: DynCd,
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_file_compressor_new(dst: *mut *mut PcoWrappedFc) -> PcoError {
+  let fc = PcoWrappedFc {
+    inner: FileCompressor::default(),
+  };
+  unsafe { *dst = Box::into_raw(Box::new(fc)) };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_file_compressor_write_header(
+  fc: *const PcoWrappedFc,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let fc = unsafe { &*fc };
+  let mut res = Vec::new();
+  match fc.inner.write_header(&mut res) {
+    Err(e) => register_err(&e),
+    Ok(_) => {
+      unsafe { (*dst).init_from_vec(res) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+fn _chunk_compressor<T: NumberLike>(
+  fc: &PcoWrappedFc,
+  nums: *const c_void,
+  len: c_uint,
+  config: &ChunkConfig,
+) -> Result<ChunkCompressor<T::L>, PcoError> {
+  let slice = unsafe { std::slice::from_raw_parts(nums as *const T, len as usize) };
+  fc.inner
+    .chunk_compressor(slice, config)
+    .map_err(|e| register_err(&e))
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_file_compressor_chunk_compressor(
+  fc: *const PcoWrappedFc,
+  nums: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  config: *const PcoChunkConfig,
+  dst: *mut *mut PcoWrappedCc,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let fc = unsafe { &*fc };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  macro_rules! match_dtype_to_cc {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => {
+          match _chunk_compressor::<$t>(fc, nums, len, &config) {
+            Ok(cc) => DynCc::$lname(cc),
+            Err(e) => return e,
+          }
+        })+
+      }
+    }
+  }
+  let dyn_cc = with_core_dtypes!(match_dtype_to_cc);
+
+  unsafe { *dst = Box::into_raw(Box::new(PcoWrappedCc(dyn_cc))) };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_wrapped_file_compressor_free(fc: *mut PcoWrappedFc) -> PcoError {
+  drop(unsafe { Box::from_raw(fc) });
+  PcoError::PcoSuccess
+}
+
+fn _write_chunk_meta<L: Latent>(cc: &ChunkCompressor<L>, dst: *mut PcoFfiVec) -> PcoError {
+  let mut res = Vec::new();
+  match cc.write_chunk_meta(&mut res) {
+    Err(e) => register_err(&e),
+    Ok(_) => {
+      unsafe { (*dst).init_from_vec(res) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+fn _write_page<L: Latent>(
+  cc: &ChunkCompressor<L>,
+  page_idx: c_uint,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  if page_idx as usize >= cc.n_per_page().len() {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "page_idx exceeds the chunk's page count",
+    );
+  }
+  let mut res = Vec::new();
+  match cc.write_page(page_idx as usize, &mut res) {
+    Err(e) => register_err(&e),
+    Ok(_) => {
+      unsafe { (*dst).init_from_vec(res) };
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+fn _n_pages<L: Latent>(cc: &ChunkCompressor<L>, dst: *mut c_uint) -> PcoError {
+  unsafe { *dst = cc.n_per_page().len() as c_uint };
+  PcoError::PcoSuccess
+}
+
+fn _page_n<L: Latent>(cc: &ChunkCompressor<L>, page_idx: c_uint, dst: *mut c_uint) -> PcoError {
+  let n_per_page = cc.n_per_page();
+  let Some(&page_n) = n_per_page.get(page_idx as usize) else {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "page_idx exceeds the chunk's page count",
+    );
+  };
+  unsafe { *dst = page_n as c_uint };
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_chunk_compressor_write_chunk_meta(
+  cc: *const PcoWrappedCc,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let dyn_cc = unsafe { &(*cc).0 };
+  macro_rules! match_cc {
+    {$($name:ident => $t:ty,)+} => {
+      match dyn_cc {
+        $(DynCc::$name(cc) => _write_chunk_meta(cc, dst),)+
+      }
+    }
+  }
+  with_core_latents!(match_cc)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_chunk_compressor_n_pages(
+  cc: *const PcoWrappedCc,
+  dst: *mut c_uint,
+) -> PcoError {
+  let dyn_cc = unsafe { &(*cc).0 };
+  macro_rules! match_cc {
+    {$($name:ident => $t:ty,)+} => {
+      match dyn_cc {
+        $(DynCc::$name(cc) => _n_pages(cc, dst),)+
+      }
+    }
+  }
+  with_core_latents!(match_cc)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_chunk_compressor_page_n(
+  cc: *const PcoWrappedCc,
+  page_idx: c_uint,
+  dst: *mut c_uint,
+) -> PcoError {
+  let dyn_cc = unsafe { &(*cc).0 };
+  macro_rules! match_cc {
+    {$($name:ident => $t:ty,)+} => {
+      match dyn_cc {
+        $(DynCc::$name(cc) => _page_n(cc, page_idx, dst),)+
+      }
+    }
+  }
+  with_core_latents!(match_cc)
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_chunk_compressor_write_page(
+  cc: *const PcoWrappedCc,
+  page_idx: c_uint,
+  dst: *mut PcoFfiVec,
+) -> PcoError {
+  let dyn_cc = unsafe { &(*cc).0 };
+  macro_rules! match_cc {
+    {$($name:ident => $t:ty,)+} => {
+      match dyn_cc {
+        $(DynCc::$name(cc) => _write_page(cc, page_idx, dst),)+
+      }
+    }
+  }
+  with_core_latents!(match_cc)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_wrapped_chunk_compressor_free(cc: *mut PcoWrappedCc) -> PcoError {
+  drop(unsafe { Box::from_raw(cc) });
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_file_decompressor_new(
+  src: *const c_void,
+  len: c_uint,
+  dst: *mut *mut PcoWrappedFd,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let slice = unsafe { std::slice::from_raw_parts(src as *const u8, len as usize) };
+  match FileDecompressor::new(slice) {
+    Err(e) => register_err(&e),
+    Ok((fd, rest)) => {
+      unsafe {
+        *n_bytes_read = (slice.len() - rest.len()) as c_uint;
+        *dst = Box::into_raw(Box::new(PcoWrappedFd { inner: fd }));
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_file_decompressor_chunk_decompressor(
+  fd: *const PcoWrappedFd,
+  src: *const c_void,
+  len: c_uint,
+  dtype: c_uchar,
+  dst: *mut *mut PcoWrappedCd,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let fd = unsafe { &*fd };
+  let slice = unsafe { std::slice::from_raw_parts(src as *const u8, len as usize) };
+
+  macro_rules! match_dtype_to_cd {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => {
+          match fd.inner.chunk_decompressor::<$t, _>(slice) {
+            Ok((cd, rest)) => (DynCd::$name(cd), rest),
+            Err(e) => return register_err(&e),
+          }
+        })+
+      }
+    }
+  }
+  let (inner, rest) = with_core_dtypes!(match_dtype_to_cd);
+
+  unsafe {
+    *n_bytes_read = (slice.len() - rest.len()) as c_uint;
+    *dst = Box::into_raw(Box::new(PcoWrappedCd { inner }));
+  }
+  PcoError::PcoSuccess
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_wrapped_file_decompressor_free(fd: *mut PcoWrappedFd) -> PcoError {
+  drop(unsafe { Box::from_raw(fd) });
+  PcoError::PcoSuccess
+}
+
+fn _decompress_page<T: NumberLike>(
+  cd: &ChunkDecompressor<T>,
+  src: &[u8],
+  page_n: c_uint,
+  dst: *mut c_void,
+  dst_len: c_uint,
+  progress_ptr: *mut PcoProgress,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let dst = unsafe { std::slice::from_raw_parts_mut(dst as *mut T, dst_len as usize) };
+  let result: Result<_, pco::errors::PcoError> = (|| {
+    let mut pd = cd.page_decompressor(src, page_n as usize)?;
+    let progress = pd.decompress(dst)?;
+    Ok((progress, pd.into_src()))
+  })();
+  match result {
+    Err(e) => register_err(&e),
+    Ok((progress, rest)) => {
+      unsafe {
+        (*progress_ptr).n_processed = progress.n_processed as c_uint;
+        (*progress_ptr).finished = progress.finished as c_uchar;
+        *n_bytes_read = (src.len() - rest.len()) as c_uint;
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+#[no_mangle]
+pub extern "C" fn pco_wrapped_chunk_decompressor_decompress_page(
+  cd: *const PcoWrappedCd,
+  src: *const c_void,
+  len: c_uint,
+  page_n: c_uint,
+  dst: *mut c_void,
+  dst_len: c_uint,
+  progress: *mut PcoProgress,
+  n_bytes_read: *mut c_uint,
+) -> PcoError {
+  let inner = unsafe { &(*cd).inner };
+  let slice = unsafe { std::slice::from_raw_parts(src as *const u8, len as usize) };
+
+  macro_rules! match_cd {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match inner {
+        $(DynCd::$name(cd) => _decompress_page::<$t>(
+          cd, slice, page_n, dst, dst_len, progress, n_bytes_read,
+        ),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_cd)
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn pco_wrapped_chunk_decompressor_free(cd: *mut PcoWrappedCd) -> PcoError {
+  drop(unsafe { Box::from_raw(cd) });
+  PcoError::PcoSuccess
+}
+
+fn _shared_compress<T: NumberLike>(
+  arrays: &[PcoArray],
+  config: &ChunkConfig,
+  meta_dst: *mut PcoFfiVec,
+  page_dsts: *mut PcoFfiVec,
+) -> PcoError {
+  let total: usize = arrays.iter().map(|array| array.len as usize).sum();
+  let mut nums = Vec::with_capacity(total);
+  for array in arrays {
+    let slice = unsafe { std::slice::from_raw_parts(array.nums as *const T, array.len as usize) };
+    nums.extend_from_slice(slice);
+  }
+  let mut config = config.clone();
+  config.paging_spec = PagingSpec::Exact(arrays.iter().map(|array| array.len as usize).collect());
+
+  let fc = FileCompressor::default();
+  let result: Result<_, pco::errors::PcoError> = (|| {
+    let mut meta = Vec::new();
+    fc.write_header(&mut meta)?;
+    let cc = fc.chunk_compressor(&nums, &config)?;
+    cc.write_chunk_meta(&mut meta)?;
+    let mut pages = Vec::with_capacity(arrays.len());
+    for page_idx in 0..arrays.len() {
+      let mut page = Vec::new();
+      cc.write_page(page_idx, &mut page)?;
+      pages.push(page);
+    }
+    Ok((meta, pages))
+  })();
+  match result {
+    Err(e) => register_err(&e),
+    Ok((meta, pages)) => {
+      unsafe {
+        (*meta_dst).init_from_vec(meta);
+        for (i, page) in pages.into_iter().enumerate() {
+          (*page_dsts.add(i)).init_from_vec(page);
+        }
+      }
+      PcoError::PcoSuccess
+    }
+  }
+}
+
+/// Compresses `n_arrays` arrays of one dtype against a single shared chunk
+/// metadata, which the wrapped format realizes natively: the arrays become the
+/// exact pages of one chunk, so the bins and ANS tables trained over all of
+/// them are serialized once. `meta_dst` receives the header and chunk metadata;
+/// `page_dsts[i]` receives array `i`'s metadata-less page bytes. The caller's
+/// `exact_page_ns` is ignored; paging always follows the array lengths.
+///
+/// This pays off when the arrays are small (say, thousands of values) and
+/// near-identically distributed, where per-array chunk metadata would dominate
+/// each array's bytes. The arrays must be presented together so the shared
+/// tables can be trained over all of them.
+#[no_mangle]
+pub extern "C" fn pco_shared_compress(
+  arrays: *const PcoArray,
+  n_arrays: size_t,
+  config: *const PcoChunkConfig,
+  meta_dst: *mut PcoFfiVec,
+  page_dsts: *mut PcoFfiVec,
+) -> PcoError {
+  let arrays = unsafe { std::slice::from_raw_parts(arrays, n_arrays) };
+  if arrays.is_empty() {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "n_arrays must be positive",
+    );
+  }
+  let dtype_byte = arrays[0].dtype;
+  if arrays.iter().any(|array| array.dtype != dtype_byte) {
+    return register_local_err(
+      PcoError::PcoInvalidArgumentError,
+      "all arrays must share one dtype",
+    );
+  }
+  let Some(dtype) = CoreDataType::from_byte(dtype_byte) else {
+    return PcoError::PcoInvalidType;
+  };
+  let config = match ChunkConfig::try_from(unsafe { &*config }) {
+    Ok(config) => config,
+    Err(e) => return e,
+  };
+
+  macro_rules! match_dtype_shared {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => _shared_compress::<$t>(arrays, &config, meta_dst, page_dsts),)+
+      }
+    }
+  }
+  with_core_dtypes!(match_dtype_shared)
+}
+
+/// Parses a shared metadata blob written by `pco_shared_compress` into a chunk
+/// decompressor handle. Decode each page stream with
+/// `pco_wrapped_chunk_decompressor_decompress_page`, passing its array's
+/// length as `page_n`; the parsed tables are reused across all pages. Free the
+/// handle with `pco_wrapped_chunk_decompressor_free`.
+#[no_mangle]
+pub extern "C" fn pco_shared_decompressor_new(
+  meta: *const c_void,
+  meta_len: c_uint,
+  dtype: c_uchar,
+  dst: *mut *mut PcoWrappedCd,
+) -> PcoError {
+  let Some(dtype) = CoreDataType::from_byte(dtype) else {
+    return PcoError::PcoInvalidType;
+  };
+  let slice = unsafe { std::slice::from_raw_parts(meta as *const u8, meta_len as usize) };
+  let (fd, rest) = match FileDecompressor::new(slice) {
+    Ok(pair) => pair,
+    Err(e) => return register_err(&e),
+  };
+
+  macro_rules! match_dtype_to_cd {
+    {$($name:ident($lname:ident) => $t:ty,)+} => {
+      match dtype {
+        $(CoreDataType::$name => {
+          match fd.chunk_decompressor::<$t, _>(rest) {
+            Ok((cd, _)) => DynCd::$name(cd),
+            Err(e) => return register_err(&e),
+          }
+        })+
+      }
+    }
+  }
+  let inner = with_core_dtypes!(match_dtype_to_cd);
+
+  unsafe { *dst = Box::into_raw(Box::new(PcoWrappedCd { inner })) };
+  PcoError::PcoSuccess
+}
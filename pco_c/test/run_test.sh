@@ -2,6 +2,19 @@
 set -e
 
 cd "${0%/*}"
-gcc -g test_cpcodec.c -o test_cpcodec -L../../target/debug -lcpcodec -Wl,-rpath,../../target/debug
-./test_cpcodec
-rm test_cpcodec
+for name in test_cpcodec test_cpcodec_wrapped test_cpcodec_streaming test_cpcodec_push; do
+  gcc -g $name.c -o $name -L../../target/debug -lcpcodec -Wl,-rpath,../../target/debug
+  ./$name
+  rm $name
+done
+
+# the same tests should pass against the static archive
+gcc -g test_cpcodec.c -o test_cpcodec_static ../../target/debug/libcpcodec.a -lpthread -ldl -lm
+./test_cpcodec_static
+rm test_cpcodec_static
+
+for name in test_cpcodec_cpp; do
+  g++ -g -std=c++17 $name.cc -o $name -L../../target/debug -lcpcodec -Wl,-rpath,../../target/debug
+  ./$name
+  rm $name
+done
@@ -1,17 +1,45 @@
 #include "../include/cpcodec.h"
 #include <stdio.h>
+#include <stdlib.h>
 
 int is_empty(struct PcoFfiVec *vec) {
   return vec->len == 0 && vec->ptr == NULL && vec->raw_box == NULL;
 }
 
+static size_t n_custom_allocs = 0;
+
+static void *counting_alloc(void *user_data, size_t size, size_t align) {
+  (void)user_data;
+  if (align < sizeof(void *)) {
+    align = sizeof(void *);
+  }
+  void *ptr = NULL;
+  if (posix_memalign(&ptr, align, size) != 0) {
+    return NULL;
+  }
+  n_custom_allocs++;
+  return ptr;
+}
+
+static void counting_free(void *user_data, void *ptr, size_t size, size_t align) {
+  (void)user_data;
+  (void)size;
+  (void)align;
+  free(ptr);
+}
+
 int main() {
   float input[] = {1.1f, 2.2f, 3.3f, 4.4f};
   int num_elems = sizeof(input) / sizeof(input[0]);
   int retcode = 0;
 
+  if (pco_set_allocator(counting_alloc, counting_free, NULL) != PcoSuccess) {
+    printf("Error setting allocator\n");
+    return 1;
+  }
+
   struct PcoFfiVec cvec;
-  enum PcoError res = pco_auto_compress(&input, num_elems, PCO_TYPE_F32, 8, &cvec);
+  enum PcoError res = pco_simpler_compress(&input, num_elems, PCO_TYPE_F32, 8, &cvec);
   if (res != PcoSuccess) {
     printf("Error compressing: %d\n", res);
     retcode = 1;
@@ -19,8 +47,23 @@ int main() {
   }
   printf("Compressed %d floats to %d bytes\n", num_elems, cvec.len);
 
+  unsigned int peeked_n = 0;
+  res = pco_peek_num_count(cvec.ptr, cvec.len, &peeked_n);
+  if (res != PcoSuccess || peeked_n != num_elems) {
+    printf("Error peeking num count: %d (got %u)\n", res, peeked_n);
+    retcode = 1;
+    goto cleanup_cvec;
+  }
+  struct PcoFileStats stats;
+  res = pco_file_stats(cvec.ptr, cvec.len, &stats);
+  if (res != PcoSuccess || stats.n_hint != num_elems || stats.first_dtype_byte != PCO_TYPE_F32) {
+    printf("Error getting file stats: %d\n", res);
+    retcode = 1;
+    goto cleanup_cvec;
+  }
+
   struct PcoFfiVec dvec;
-  res = pco_auto_decompress(cvec.ptr, cvec.len, PCO_TYPE_F32, &dvec);
+  res = pco_simple_decompress(cvec.ptr, cvec.len, PCO_TYPE_F32, &dvec);
   if (res != PcoSuccess) {
     printf("Error decompressing: %d\n", res);
     pco_free_pcovec(&cvec);
@@ -43,6 +86,126 @@ int main() {
   }
   printf("Values match\n");
 
+  float into_buf[4];
+  struct PcoProgress progress;
+  res = pco_simple_decompress_into(cvec.ptr, cvec.len, PCO_TYPE_F32, &into_buf, num_elems, &progress);
+  if (res != PcoSuccess) {
+    printf("Error decompressing into buffer: %d\n", res);
+    retcode = 1;
+    goto cleanup_all;
+  }
+  if (progress.n_processed != num_elems || !progress.finished) {
+    printf("Unexpected progress decompressing into buffer!!!\n");
+    retcode = 1;
+    goto cleanup_all;
+  }
+  for (int i = 0; i < num_elems; i++) {
+    if (input[i] != into_buf[i]) {
+      printf("Values decompressed into buffer do not match!!!\n");
+      retcode = 1;
+      goto cleanup_all;
+    }
+  }
+  printf("Values decompressed into buffer match\n");
+
+  // the same round trip through the size_t-based entry points
+  struct PcoFfiVec64 cvec64;
+  res = pco_simpler_compress64(&input, (size_t)num_elems, PCO_TYPE_F32, 8, &cvec64);
+  if (res != PcoSuccess) {
+    printf("Error compressing with 64-bit lengths: %d\n", res);
+    retcode = 1;
+    goto cleanup_all;
+  }
+  struct PcoFfiVec64 dvec64;
+  res = pco_simple_decompress64(cvec64.ptr, cvec64.len, PCO_TYPE_F32, &dvec64);
+  if (res != PcoSuccess) {
+    printf("Error decompressing with 64-bit lengths: %d\n", res);
+    pco_free_pcovec64(&cvec64);
+    retcode = 1;
+    goto cleanup_all;
+  }
+  if (dvec64.len != (size_t)num_elems) {
+    printf("64-bit sizes do not match!!!\n");
+    retcode = 1;
+  }
+  for (int i = 0; retcode == 0 && i < num_elems; i++) {
+    if (input[i] != ((float *)dvec64.ptr)[i]) {
+      printf("64-bit values do not match!!!\n");
+      retcode = 1;
+    }
+  }
+  pco_free_pcovec64(&dvec64);
+  pco_free_pcovec64(&cvec64);
+  if (retcode != 0) {
+    goto cleanup_all;
+  }
+  printf("Values match through 64-bit lengths\n");
+
+  // compressing into a pre-sized caller buffer should produce the same bytes
+  size_t max_size = 0;
+  if (pco_max_compressed_size(num_elems, PCO_TYPE_F32, NULL, &max_size) != PcoSuccess ||
+      max_size < cvec.len) {
+    printf("Error bounding compressed size\n");
+    retcode = 1;
+    goto cleanup_all;
+  }
+  unsigned char *into_bytes = malloc(max_size);
+  size_t n_bytes_written = 0;
+  struct PcoChunkConfig into_config;
+  pco_default_chunk_config(&into_config);
+  res = pco_simple_compress_into(&input, num_elems, PCO_TYPE_F32, &into_config, into_bytes,
+                                 max_size, &n_bytes_written);
+  int into_matches = res == PcoSuccess && n_bytes_written == cvec.len;
+  for (size_t i = 0; into_matches && i < n_bytes_written; i++) {
+    into_matches = into_bytes[i] == ((const unsigned char *)cvec.ptr)[i];
+  }
+  free(into_bytes);
+  if (!into_matches) {
+    printf("Compressing into buffer does not match!!!\n");
+    retcode = 1;
+    goto cleanup_all;
+  }
+  printf("Compressed %zu bytes into pre-sized buffer (bound %zu)\n", n_bytes_written, max_size);
+
+  // a stored f64 column should decompress straight into a float buffer
+  double dbl_input[1000];
+  for (int i = 0; i < 1000; i++) {
+    dbl_input[i] = i * 0.5;
+  }
+  struct PcoFfiVec dbl_cvec;
+  res = pco_simpler_compress(&dbl_input, 1000, PCO_TYPE_F64, 8, &dbl_cvec);
+  if (res != PcoSuccess) {
+    printf("Error compressing doubles: %d\n", res);
+    retcode = 1;
+    goto cleanup_all;
+  }
+  float cast_buf[1000];
+  unsigned int cast_n = 0;
+  res = pco_decompress_cast(dbl_cvec.ptr, dbl_cvec.len, PCO_TYPE_F64, PCO_TYPE_F32, cast_buf,
+                            1000, &cast_n);
+  int cast_matches = res == PcoSuccess && cast_n == 1000;
+  for (int i = 0; cast_matches && i < 1000; i++) {
+    cast_matches = cast_buf[i] == (float)dbl_input[i];
+  }
+  pco_free_pcovec(&dbl_cvec);
+  if (!cast_matches) {
+    printf("Cast values do not match!!!\n");
+    retcode = 1;
+    goto cleanup_all;
+  }
+  printf("Cast values match\n");
+
+  // the feature report backs the cast kernels' runtime dispatch
+  struct PcoCpuFeatures features;
+  if (pco_cpu_features(&features) != PcoSuccess || features.detected_avx2 > 1 ||
+      features.detected_avx512f > 1 || features.detected_neon > 1) {
+    printf("Error reading CPU features\n");
+    retcode = 1;
+    goto cleanup_all;
+  }
+  printf("CPU features: avx2=%d avx512f=%d neon=%d\n", features.detected_avx2,
+         features.detected_avx512f, features.detected_neon);
+
 cleanup_all:
   pco_free_pcovec(&dvec);
   if (!is_empty(&dvec)) {
@@ -56,5 +219,9 @@ cleanup_cvec:
     retcode = 1;
   }
 cleanup_none:
+  if (n_custom_allocs == 0) {
+    printf("Custom allocator was never used!!!\n");
+    retcode = 1;
+  }
   return retcode;
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "../include/cpcodec.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#define N 100000
+
+// Round trips through the C++ wrapper, checking RAII vectors, the
+// compile-time dtype mapping, and exceptions carrying the error message.
+int main() {
+  std::vector<std::int64_t> input(N);
+  std::vector<double> dbl_input(N);
+  for (int i = 0; i < N; i++) {
+    input[i] = 2 * static_cast<std::int64_t>(i) * i;
+    dbl_input[i] = i * 0.125;
+  }
+
+  try {
+    pco::bytes compressed = pco::simpler_compress(input.data(), input.size(), 8);
+    std::printf("Compressed %d longs to %zu bytes\n", N, compressed.size());
+    pco::vec<std::int64_t> output =
+      pco::simple_decompress<std::int64_t>(compressed.data(), compressed.size());
+    if (output.size() != N) {
+      std::printf("Wrong decompressed count!!!\n");
+      return 1;
+    }
+    for (int i = 0; i < N; i++) {
+      if (output[i] != input[i]) {
+        std::printf("Values do not match!!!\n");
+        return 1;
+      }
+    }
+    std::printf("Values match\n");
+
+    PcoChunkConfig config = pco::default_chunk_config();
+    config.compression_level = 6;
+    pco::bytes dbl_compressed =
+      pco::simple_compress(dbl_input.data(), dbl_input.size(), config);
+    pco::vec<double> dbl_output =
+      pco::simple_decompress<double>(dbl_compressed.data(), dbl_compressed.size());
+    if (dbl_output.size() != N) {
+      std::printf("Wrong double count!!!\n");
+      return 1;
+    }
+    for (int i = 0; i < N; i++) {
+      if (dbl_output[i] != dbl_input[i]) {
+        std::printf("Double values do not match!!!\n");
+        return 1;
+      }
+    }
+    std::printf("Double values match\n");
+  } catch (const pco::error& e) {
+    std::printf("Unexpected pco error: %s\n", e.what());
+    return 1;
+  }
+
+  // garbage bytes should surface as an exception, not a crash
+  const unsigned char garbage[] = {1, 2, 3, 4};
+  try {
+    pco::simple_decompress<std::int32_t>(garbage, sizeof(garbage));
+    std::printf("Expected an error for garbage bytes\n");
+    return 1;
+  } catch (const pco::error& e) {
+    std::printf("Garbage bytes error: %s\n", e.what());
+  }
+  return 0;
+}
@@ -0,0 +1,243 @@
+#include "../include/cpcodec.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N 250000
+#define CHUNK_N 100000
+
+// Pushes uneven slices through the incremental compressor, pulling finished
+// bytes as they become available, then round trips the stitched file.
+int main() {
+  int *input = malloc(N * sizeof(int));
+  for (int i = 0; i < N; i++) {
+    input[i] = 3 * i + i % 7;
+  }
+  int retcode = 1;
+
+  struct PcoChunkConfig config;
+  pco_default_chunk_config(&config);
+  config.max_page_n = CHUNK_N;
+
+  struct PcoCompressor *compressor = NULL;
+  unsigned char *compressed = NULL;
+  unsigned int compressed_len = 0;
+  if (pco_compressor_new(PCO_TYPE_I32, &config, &compressor) != PcoSuccess) {
+    printf("Error creating compressor\n");
+    goto cleanup;
+  }
+
+  unsigned int slice_ns[] = {1, 70000, 129999, 30000, 20000};
+  unsigned int pushed = 0;
+  for (int i = 0; i < 5; i++) {
+    if (pco_compressor_push(compressor, &input[pushed], slice_ns[i]) != PcoSuccess) {
+      printf("Error pushing slice\n");
+      goto cleanup;
+    }
+    pushed += slice_ns[i];
+
+    struct PcoFfiVec bytes;
+    if (pco_compressor_pull(compressor, &bytes) != PcoSuccess) {
+      printf("Error pulling bytes\n");
+      goto cleanup;
+    }
+    compressed = realloc(compressed, compressed_len + bytes.len);
+    memcpy(&compressed[compressed_len], bytes.ptr, bytes.len);
+    compressed_len += bytes.len;
+    pco_free_pcovec(&bytes);
+  }
+
+  struct PcoFfiVec tail;
+  if (pco_compressor_finish(compressor, &tail) != PcoSuccess) {
+    printf("Error finishing\n");
+    goto cleanup;
+  }
+  compressed = realloc(compressed, compressed_len + tail.len);
+  memcpy(&compressed[compressed_len], tail.ptr, tail.len);
+  compressed_len += tail.len;
+  pco_free_pcovec(&tail);
+  printf("Pushed %u ints into %u compressed bytes\n", pushed, compressed_len);
+
+  struct PcoStats cstats;
+  if (pco_compressor_stats(compressor, &cstats) != PcoSuccess || cstats.n_processed != N ||
+      cstats.n_bytes != compressed_len || cstats.meta_nanos == 0) {
+    printf("Unexpected compressor stats!!!\n");
+    goto cleanup;
+  }
+  printf("Compressor stats: meta %" PRIu64 "ns, pages %" PRIu64 "ns\n", cstats.meta_nanos,
+         cstats.page_nanos);
+
+  struct PcoFfiVec dvec;
+  if (pco_simple_decompress(compressed, compressed_len, PCO_TYPE_I32, &dvec) != PcoSuccess) {
+    printf("Error decompressing\n");
+    goto cleanup;
+  }
+  int matches = dvec.len == N;
+  for (int i = 0; matches && i < N; i++) {
+    matches = ((const int *)dvec.ptr)[i] == input[i];
+  }
+  pco_free_pcovec(&dvec);
+  if (!matches) {
+    printf("Values do not match!!!\n");
+    goto cleanup;
+  }
+  printf("Values match\n");
+
+  // a context trained on a sample should round trip many small arrays
+  struct PcoContext *context = NULL;
+  if (pco_context_new(input, 5000, PCO_TYPE_I32, NULL, &context) != PcoSuccess) {
+    printf("Error training context\n");
+    goto cleanup;
+  }
+  for (int arr = 0; arr < 8; arr++) {
+    const int *arr_input = &input[arr * 2000];
+    struct PcoFfiVec arr_cvec;
+    if (pco_context_compress(context, arr_input, 2000, &arr_cvec) != PcoSuccess) {
+      printf("Error compressing with context\n");
+      goto cleanup_context;
+    }
+    struct PcoFfiVec arr_dvec;
+    if (pco_simple_decompress(arr_cvec.ptr, arr_cvec.len, PCO_TYPE_I32, &arr_dvec) !=
+        PcoSuccess) {
+      printf("Error decompressing context output\n");
+      pco_free_pcovec(&arr_cvec);
+      goto cleanup_context;
+    }
+    int arr_matches = arr_dvec.len == 2000;
+    for (int i = 0; arr_matches && i < 2000; i++) {
+      arr_matches = ((const int *)arr_dvec.ptr)[i] == arr_input[i];
+    }
+    pco_free_pcovec(&arr_cvec);
+    pco_free_pcovec(&arr_dvec);
+    if (!arr_matches) {
+      printf("Context values do not match!!!\n");
+      goto cleanup_context;
+    }
+  }
+  printf("Context values match\n");
+
+  // detection as a standalone step: the detected config should be concrete
+  // and replayable through the ordinary config-taking entry points
+  struct PcoChunkConfig detected;
+  if (pco_detect_config(input, 5000, PCO_TYPE_I32, NULL, &detected) != PcoSuccess) {
+    printf("Error detecting config\n");
+    goto cleanup_context;
+  }
+  if (detected.delta_encoding_order < 0) {
+    printf("Detected config still has automatic delta order!!!\n");
+    goto cleanup_context;
+  }
+  struct PcoFfiVec det_cvec;
+  if (pco_simple_compress(input, 10000, PCO_TYPE_I32, &detected, &det_cvec) != PcoSuccess) {
+    printf("Error compressing with detected config\n");
+    goto cleanup_context;
+  }
+  struct PcoFfiVec det_dvec;
+  int det_matches =
+    pco_simple_decompress(det_cvec.ptr, det_cvec.len, PCO_TYPE_I32, &det_dvec) == PcoSuccess;
+  if (det_matches) {
+    det_matches = det_dvec.len == 10000 && memcmp(det_dvec.ptr, input, 10000 * sizeof(int)) == 0;
+    pco_free_pcovec(&det_dvec);
+  }
+  pco_free_pcovec(&det_cvec);
+  if (!det_matches) {
+    printf("Detected config values do not match!!!\n");
+    goto cleanup_context;
+  }
+  printf("Detected config: delta_order=%d\n", detected.delta_encoding_order);
+
+  // a batch call should compress mixed-dtype columns in one crossing
+  double dbl_input[3000];
+  for (int i = 0; i < 3000; i++) {
+    dbl_input[i] = i * 0.25;
+  }
+  struct PcoArray arrays[2] = {
+    {input, 10000, PCO_TYPE_I32},
+    {dbl_input, 3000, PCO_TYPE_F64},
+  };
+  struct PcoFfiVec batch_cvecs[2];
+  if (pco_compress_batch(arrays, 2, NULL, 2, batch_cvecs) != PcoSuccess) {
+    printf("Error compressing batch\n");
+    goto cleanup_context;
+  }
+  int batch_matches = 1;
+  for (int a = 0; a < 2; a++) {
+    struct PcoFfiVec batch_dvec;
+    if (pco_simple_decompress(batch_cvecs[a].ptr, batch_cvecs[a].len, arrays[a].dtype,
+                              &batch_dvec) != PcoSuccess) {
+      printf("Error decompressing batch output\n");
+      batch_matches = 0;
+      break;
+    }
+    batch_matches = batch_dvec.len == arrays[a].len &&
+                    memcmp(batch_dvec.ptr, arrays[a].nums,
+                           batch_dvec.len * (a == 0 ? sizeof(int) : sizeof(double))) == 0;
+    pco_free_pcovec(&batch_dvec);
+    if (!batch_matches) {
+      break;
+    }
+  }
+  pco_free_pcovec(&batch_cvecs[0]);
+  pco_free_pcovec(&batch_cvecs[1]);
+  if (!batch_matches) {
+    printf("Batch values do not match!!!\n");
+    goto cleanup_context;
+  }
+  printf("Batch values match\n");
+
+  // a timestamp + value + quality row group container should round trip
+  // through one buffer per column
+  long ts_col[3000];
+  for (int i = 0; i < 3000; i++) {
+    ts_col[i] = 1700000000000L + 250L * i;
+  }
+  struct PcoArray columns[3] = {
+    {ts_col, 3000, PCO_TYPE_I64},
+    {dbl_input, 3000, PCO_TYPE_F64},
+    {input, 3000, PCO_TYPE_I32},
+  };
+  struct PcoChunkConfig multi_config;
+  pco_default_chunk_config(&multi_config);
+  multi_config.max_page_n = 1000; // 3 row groups
+  struct PcoFfiVec multi_cvec;
+  if (pco_multi_compress(columns, 3, &multi_config, &multi_cvec) != PcoSuccess) {
+    printf("Error compressing columns\n");
+    goto cleanup_context;
+  }
+  size_t multi_n_columns = 0;
+  unsigned int multi_n_rows = 0;
+  unsigned char multi_dtypes[3];
+  int multi_ok = pco_multi_inspect(multi_cvec.ptr, multi_cvec.len, multi_dtypes, 3,
+                                   &multi_n_columns, &multi_n_rows) == PcoSuccess &&
+                 multi_n_columns == 3 && multi_n_rows == 3000 &&
+                 multi_dtypes[0] == PCO_TYPE_I64 && multi_dtypes[1] == PCO_TYPE_F64 &&
+                 multi_dtypes[2] == PCO_TYPE_I32;
+  long ts_out[3000];
+  double dbl_out[3000];
+  int int_out[3000];
+  void *multi_dsts[3] = {ts_out, dbl_out, int_out};
+  multi_ok = multi_ok &&
+             pco_multi_decompress(multi_cvec.ptr, multi_cvec.len, multi_dsts, 3, 3000,
+                                  &multi_n_rows) == PcoSuccess &&
+             multi_n_rows == 3000 && memcmp(ts_out, ts_col, sizeof(ts_col)) == 0 &&
+             memcmp(dbl_out, dbl_input, sizeof(dbl_input)) == 0 &&
+             memcmp(int_out, input, 3000 * sizeof(int)) == 0;
+  pco_free_pcovec(&multi_cvec);
+  if (!multi_ok) {
+    printf("Multi-column values do not match!!!\n");
+    goto cleanup_context;
+  }
+  printf("Multi-column values match across %u rows\n", multi_n_rows);
+  retcode = 0;
+
+cleanup_context:
+  pco_context_free(context);
+cleanup:
+  if (compressor != NULL) {
+    pco_compressor_free(compressor);
+  }
+  free(compressed);
+  free(input);
+  return retcode;
+}
@@ -0,0 +1,376 @@
+#include "../include/cpcodec.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N 300000
+
+static unsigned char cancel_flag = 0;
+
+static unsigned char should_cancel(void *user_data) {
+  return *(unsigned char *)user_data;
+}
+
+// Decodes a multi-chunk standalone file one chunk at a time through the
+// streaming PcoDecompressor handle.
+int main() {
+  int *input = malloc(N * sizeof(int));
+  int *output = malloc(N * sizeof(int));
+  for (int i = 0; i < N; i++) {
+    input[i] = i * i;
+  }
+  int retcode = 1;
+
+  struct PcoFfiVec cvec;
+  struct PcoDecompressor *decompressor = NULL;
+  struct PcoDecompressor *async_decompressor = NULL;
+  if (pco_simpler_compress(input, N, PCO_TYPE_I32, 8, &cvec) != PcoSuccess) {
+    printf("Error compressing\n");
+    goto cleanup_none;
+  }
+
+  const unsigned char *src = cvec.ptr;
+  unsigned int remaining = cvec.len;
+  unsigned int n_bytes_read = 0;
+  if (pco_decompressor_new(src, remaining, PCO_TYPE_I32, &decompressor, &n_bytes_read) !=
+      PcoSuccess) {
+    printf("Error creating decompressor\n");
+    goto cleanup;
+  }
+  src += n_bytes_read;
+  remaining -= n_bytes_read;
+
+  // a truncated chunk should ask for more data rather than failing hard
+  if (pco_decompressor_decompress_chunk(decompressor, src, 10, output, N, &n_bytes_read,
+                                        &n_bytes_read) != PcoInsufficientDataError) {
+    printf("Expected insufficient data error on truncated chunk\n");
+    goto cleanup;
+  }
+  char err_msg[256];
+  if (pco_last_error_message(err_msg, sizeof(err_msg)) != PcoSuccess || err_msg[0] == '\0') {
+    printf("Expected an error message for the truncated chunk\n");
+    goto cleanup;
+  }
+  printf("Truncated chunk error: %s\n", err_msg);
+
+  // an expired deadline or a firing callback should abandon the decode at a
+  // batch boundary; the walk below still runs with the callback installed
+  unsigned int cancel_n = 0;
+  pco_decompressor_set_deadline(decompressor, 1);
+  if (pco_decompressor_decompress_chunk(decompressor, src, remaining, output, N, &cancel_n,
+                                        &n_bytes_read) != PcoCancelledError) {
+    printf("Expected cancelled error for expired deadline\n");
+    goto cleanup;
+  }
+  pco_decompressor_set_deadline(decompressor, 0);
+  cancel_flag = 1;
+  pco_decompressor_set_cancel(decompressor, should_cancel, &cancel_flag);
+  if (pco_decompressor_decompress_chunk(decompressor, src, remaining, output, N, &cancel_n,
+                                        &n_bytes_read) != PcoCancelledError) {
+    printf("Expected cancelled error from callback\n");
+    goto cleanup;
+  }
+  cancel_flag = 0;
+  printf("Cancellation works\n");
+
+  unsigned int n_decompressed = 0;
+  unsigned int n_chunks = 0;
+  unsigned int chunk_offsets[16];
+  while (1) {
+    unsigned int chunk_n = 0;
+    if (n_chunks < 16) {
+      chunk_offsets[n_chunks] = (unsigned int)(src - (const unsigned char *)cvec.ptr);
+    }
+    if (pco_decompressor_decompress_chunk(decompressor, src, remaining,
+                                          &output[n_decompressed], N - n_decompressed,
+                                          &chunk_n, &n_bytes_read) != PcoSuccess) {
+      printf("Error decompressing chunk\n");
+      goto cleanup;
+    }
+    src += n_bytes_read;
+    remaining -= n_bytes_read;
+    if (chunk_n == 0) {
+      break;
+    }
+    n_decompressed += chunk_n;
+    n_chunks++;
+  }
+  printf("Decompressed %u values from %u chunks\n", n_decompressed, n_chunks);
+
+  struct PcoStats dstats;
+  if (pco_decompressor_stats(decompressor, &dstats) != PcoSuccess ||
+      dstats.n_processed != n_decompressed || dstats.n_bytes == 0 || dstats.page_nanos == 0) {
+    printf("Unexpected decompressor stats!!!\n");
+    goto cleanup;
+  }
+  printf("Decompressor stats: meta %" PRIu64 "ns, pages %" PRIu64 "ns over %" PRIu64 " bytes\n",
+         dstats.meta_nanos, dstats.page_nanos, dstats.n_bytes);
+
+  if (n_decompressed != N || n_chunks < 2) {
+    printf("Unexpected chunk structure!!!\n");
+    goto cleanup;
+  }
+  for (int i = 0; i < N; i++) {
+    if (input[i] != output[i]) {
+      printf("Values do not match!!!\n");
+      goto cleanup;
+    }
+  }
+  printf("Values match\n");
+
+  // the same walk through the async pipeline: await chunk k while the next
+  // call has chunk k+1 decoding on the worker thread
+  int *async_output = malloc(N * sizeof(int));
+  const unsigned char *async_src = (const unsigned char *)cvec.ptr;
+  unsigned int async_remaining = cvec.len;
+  if (pco_decompressor_new(async_src, async_remaining, PCO_TYPE_I32, &async_decompressor,
+                           &n_bytes_read) != PcoSuccess) {
+    printf("Error creating async decompressor\n");
+    free(async_output);
+    goto cleanup;
+  }
+  async_src += n_bytes_read;
+  async_remaining -= n_bytes_read;
+  unsigned int async_n_decompressed = 0;
+  int async_ok = 1;
+  while (async_ok) {
+    unsigned int chunk_n = 0;
+    async_ok = pco_decompressor_decompress_chunk_async(
+                 async_decompressor, async_src, async_remaining,
+                 &async_output[async_n_decompressed],
+                 N - async_n_decompressed) == PcoSuccess;
+    // a second submission must be refused while one is in flight
+    async_ok = async_ok &&
+               pco_decompressor_decompress_chunk_async(async_decompressor, async_src,
+                                                       async_remaining, async_output,
+                                                       N) == PcoInvalidArgumentError;
+    async_ok = async_ok && pco_decompressor_await_chunk(async_decompressor, &chunk_n,
+                                                        &n_bytes_read) == PcoSuccess;
+    if (!async_ok || chunk_n == 0) {
+      break;
+    }
+    async_src += n_bytes_read;
+    async_remaining -= n_bytes_read;
+    async_n_decompressed += chunk_n;
+  }
+  async_ok = async_ok && async_n_decompressed == N &&
+             memcmp(async_output, input, N * sizeof(int)) == 0;
+  // awaiting with nothing in flight is an error, not a hang
+  unsigned int idle_n = 0;
+  async_ok = async_ok && pco_decompressor_await_chunk(async_decompressor, &idle_n,
+                                                      &n_bytes_read) == PcoInvalidArgumentError;
+  free(async_output);
+  if (!async_ok) {
+    printf("Async values do not match!!!\n");
+    goto cleanup;
+  }
+  printf("Async values match\n");
+
+  // chunk metadata should be readable without decoding any page
+  struct PcoChunkStats stats;
+  if (pco_inspect(cvec.ptr, cvec.len, PCO_TYPE_I32, &stats) != PcoSuccess) {
+    printf("Error inspecting\n");
+    goto cleanup;
+  }
+  if (stats.n != n_decompressed / n_chunks || stats.n_latent_vars == 0 ||
+      stats.latent_vars[0].n_bins == 0) {
+    printf("Unexpected chunk stats!!!\n");
+    goto cleanup;
+  }
+  printf("Chunk stats: n=%u mode=%d delta_order=%u bins=%u\n", stats.n, (int)stats.mode,
+         stats.delta_encoding_order, stats.latent_vars[0].n_bins);
+
+  // parallel compression should produce the same file as the serial path
+  struct PcoChunkConfig config;
+  pco_default_chunk_config(&config);
+  struct PcoFfiVec pvec;
+  if (pco_compress_parallel(input, N, PCO_TYPE_I32, &config, 4, &pvec) != PcoSuccess) {
+    printf("Error compressing in parallel\n");
+    goto cleanup;
+  }
+  int parallel_matches = pvec.len == cvec.len;
+  for (unsigned int i = 0; parallel_matches && i < pvec.len; i++) {
+    parallel_matches = ((const unsigned char *)pvec.ptr)[i] == ((const unsigned char *)cvec.ptr)[i];
+  }
+  pco_free_pcovec(&pvec);
+  if (!parallel_matches) {
+    printf("Parallel compression does not match serial compression!!!\n");
+    goto cleanup;
+  }
+  printf("Parallel compression matches\n");
+
+  // parallel decompression across chunks, given their byte offsets
+  int *parallel_output = malloc(N * sizeof(int));
+  unsigned int parallel_n = 0;
+  enum PcoError res = pco_decompress_chunks_parallel(
+    cvec.ptr, cvec.len, PCO_TYPE_I32, chunk_offsets, n_chunks, 4, parallel_output, N,
+    &parallel_n);
+  int parallel_decompress_ok = res == PcoSuccess && parallel_n == N;
+  for (int i = 0; parallel_decompress_ok && i < N; i++) {
+    parallel_decompress_ok = parallel_output[i] == input[i];
+  }
+  free(parallel_output);
+  if (!parallel_decompress_ok) {
+    printf("Parallel decompression does not match!!!\n");
+    goto cleanup;
+  }
+  printf("Parallel decompression matches\n");
+
+  // range decompression, including ranges crossing the chunk boundary and
+  // running past the end of the file
+  unsigned int range_starts[] = {0, 149998, 299990, 299995};
+  unsigned int range_ends[] = {5, 150003, 300000, 300010};
+  for (int r = 0; r < 4; r++) {
+    int range_buf[20];
+    unsigned int range_n = 0;
+    if (pco_decompress_range(cvec.ptr, cvec.len, PCO_TYPE_I32, range_starts[r], range_ends[r],
+                             range_buf, &range_n) != PcoSuccess) {
+      printf("Error decompressing range\n");
+      goto cleanup;
+    }
+    unsigned int expected_n =
+      (range_ends[r] < N ? range_ends[r] : N) - range_starts[r];
+    if (range_n != expected_n) {
+      printf("Unexpected range count!!!\n");
+      goto cleanup;
+    }
+    for (unsigned int i = 0; i < range_n; i++) {
+      if (range_buf[i] != input[range_starts[r] + i]) {
+        printf("Range values do not match!!!\n");
+        goto cleanup;
+      }
+    }
+  }
+  printf("Range values match\n");
+
+  // a seek index should report the same chunk offsets the walk found and
+  // keep the file decodable by index-unaware entry points
+  config.enable_seek_index = 1;
+  struct PcoFfiVec ivec;
+  if (pco_simple_compress(input, N, PCO_TYPE_I32, &config, &ivec) != PcoSuccess) {
+    printf("Error compressing with seek index\n");
+    goto cleanup;
+  }
+  struct PcoSeekEntry seek_entries[16];
+  size_t n_seek_entries = 0;
+  if (pco_parse_seek_index(ivec.ptr, ivec.len, seek_entries, 16, &n_seek_entries) !=
+      PcoSuccess) {
+    printf("Error parsing seek index\n");
+    pco_free_pcovec(&ivec);
+    goto cleanup;
+  }
+  int seek_ok = n_seek_entries == n_chunks;
+  for (unsigned int c = 0; seek_ok && c < n_chunks; c++) {
+    seek_ok = seek_entries[c].byte_offset == chunk_offsets[c] &&
+              seek_entries[c].cum_n == c * (N / n_chunks);
+  }
+  int seek_buf[10];
+  unsigned int seek_n = 0;
+  seek_ok = seek_ok &&
+            pco_decompress_range(ivec.ptr, ivec.len, PCO_TYPE_I32, N - 5, N, seek_buf,
+                                 &seek_n) == PcoSuccess &&
+            seek_n == 5;
+  for (unsigned int i = 0; seek_ok && i < seek_n; i++) {
+    seek_ok = seek_buf[i] == input[N - 5 + i];
+  }
+  // point lookups, on both the indexed file and the plain one
+  unsigned int nth_idxs[] = {0, 149999, 150000, N - 1};
+  for (int i = 0; seek_ok && i < 4; i++) {
+    int nth = 0;
+    seek_ok = pco_get_nth(ivec.ptr, ivec.len, PCO_TYPE_I32, nth_idxs[i], &nth) == PcoSuccess &&
+              nth == input[nth_idxs[i]] &&
+              pco_get_nth(cvec.ptr, cvec.len, PCO_TYPE_I32, nth_idxs[i], &nth) == PcoSuccess &&
+              nth == input[nth_idxs[i]];
+  }
+  int nth_oob = 0;
+  seek_ok = seek_ok && pco_get_nth(ivec.ptr, ivec.len, PCO_TYPE_I32, N, &nth_oob) ==
+                         PcoInvalidArgumentError;
+  struct PcoFfiVec idvec;
+  seek_ok = seek_ok &&
+            pco_simple_decompress(ivec.ptr, ivec.len, PCO_TYPE_I32, &idvec) == PcoSuccess;
+  if (seek_ok) {
+    seek_ok = idvec.len == N && memcmp(idvec.ptr, input, N * sizeof(int)) == 0;
+    pco_free_pcovec(&idvec);
+  }
+  pco_free_pcovec(&ivec);
+  if (!seek_ok) {
+    printf("Seek index does not match!!!\n");
+    goto cleanup;
+  }
+  printf("Seek index matches\n");
+
+  // repeated identical decodes must allocate the same amount, so
+  // steady-state scans cannot leak or grow scratch per call
+  uint64_t alloc_deltas[3];
+  for (int i = 0; i < 3; i++) {
+    uint64_t allocs_before, allocs_after, alloc_bytes;
+    pco_alloc_stats(&allocs_before, &alloc_bytes);
+    int alloc_buf[10];
+    unsigned int alloc_n = 0;
+    if (pco_decompress_range(cvec.ptr, cvec.len, PCO_TYPE_I32, 149998, 150003, alloc_buf,
+                             &alloc_n) != PcoSuccess) {
+      printf("Error decompressing during allocation check\n");
+      goto cleanup;
+    }
+    pco_alloc_stats(&allocs_after, &alloc_bytes);
+    alloc_deltas[i] = allocs_after - allocs_before;
+  }
+  if (alloc_deltas[1] != alloc_deltas[2]) {
+    printf("Allocation profile is not steady!!!\n");
+    goto cleanup;
+  }
+  printf("Allocation profile is steady: %" PRIu64 " allocations per decode\n", alloc_deltas[1]);
+
+  // a memory-mapped file should support the same range decoding zero-copy
+  const char *mapped_path = "/tmp/test_cpcodec_streaming.pco";
+  FILE *f = fopen(mapped_path, "wb");
+  if (f == NULL || fwrite(cvec.ptr, 1, cvec.len, f) != cvec.len || fclose(f) != 0) {
+    printf("Error writing mapped test file\n");
+    goto cleanup;
+  }
+  struct PcoMapped *mapped = NULL;
+  if (pco_open_mapped(mapped_path, &mapped) != PcoSuccess) {
+    printf("Error opening mapped file\n");
+    goto cleanup;
+  }
+  unsigned int mapped_n_hint = 0;
+  unsigned char mapped_dtype = 0;
+  size_t mapped_len = 0;
+  const void *mapped_ptr = NULL;
+  pco_mapped_n_hint(mapped, &mapped_n_hint);
+  pco_mapped_dtype(mapped, &mapped_dtype);
+  pco_mapped_bytes(mapped, &mapped_ptr, &mapped_len);
+  int mapped_ok = mapped_n_hint == N && mapped_dtype == PCO_TYPE_I32 &&
+                  mapped_len == cvec.len;
+  int mapped_buf[10];
+  unsigned int mapped_n = 0;
+  mapped_ok = mapped_ok &&
+              pco_mapped_decompress_range(mapped, PCO_TYPE_I32, 149998, 150003, mapped_buf,
+                                          &mapped_n) == PcoSuccess &&
+              mapped_n == 5;
+  for (unsigned int i = 0; mapped_ok && i < mapped_n; i++) {
+    mapped_ok = mapped_buf[i] == input[149998 + i];
+  }
+  pco_close_mapped(mapped);
+  remove(mapped_path);
+  if (!mapped_ok) {
+    printf("Mapped values do not match!!!\n");
+    goto cleanup;
+  }
+  printf("Mapped values match\n");
+  retcode = 0;
+
+cleanup:
+  if (async_decompressor != NULL) {
+    pco_decompressor_free(async_decompressor);
+  }
+  if (decompressor != NULL) {
+    pco_decompressor_free(decompressor);
+  }
+  pco_free_pcovec(&cvec);
+cleanup_none:
+  free(input);
+  free(output);
+  return retcode;
+}
@@ -0,0 +1,185 @@
+#include "../include/cpcodec.h"
+#include <stdio.h>
+#include <string.h>
+
+#define N 1000
+
+// Round trips a chunk through the wrapped API, keeping the header, chunk
+// metadata, and pages as separate byte ranges the way an outer file format
+// would store them.
+int main() {
+  long input[N];
+  for (int i = 0; i < N; i++) {
+    input[i] = 10 * i;
+  }
+  int retcode = 1;
+
+  struct PcoWrappedFc *fc = NULL;
+  struct PcoWrappedCc *cc = NULL;
+  struct PcoWrappedFd *fd = NULL;
+  struct PcoWrappedCd *cd = NULL;
+  struct PcoFfiVec header, chunk_meta;
+  struct PcoFfiVec pages[8];
+  unsigned int page_ns[8];
+  unsigned int n_pages = 0;
+  memset(&header, 0, sizeof(header));
+  memset(&chunk_meta, 0, sizeof(chunk_meta));
+  memset(pages, 0, sizeof(pages));
+
+  if (pco_wrapped_file_compressor_new(&fc) != PcoSuccess) {
+    printf("Error creating file compressor\n");
+    goto cleanup;
+  }
+  if (pco_wrapped_file_compressor_write_header(fc, &header) != PcoSuccess) {
+    printf("Error writing header\n");
+    goto cleanup;
+  }
+  struct PcoChunkConfig config;
+  pco_default_chunk_config(&config);
+  config.delta_encoding_order = 1;
+  unsigned int exact_page_ns[] = {400, 600};
+  config.exact_page_ns = exact_page_ns;
+  config.n_exact_pages = 2;
+  if (pco_wrapped_file_compressor_chunk_compressor(fc, &input, N, PCO_TYPE_I64, &config, &cc) !=
+      PcoSuccess) {
+    printf("Error creating chunk compressor\n");
+    goto cleanup;
+  }
+  if (pco_wrapped_chunk_compressor_write_chunk_meta(cc, &chunk_meta) != PcoSuccess) {
+    printf("Error writing chunk meta\n");
+    goto cleanup;
+  }
+  if (pco_wrapped_chunk_compressor_n_pages(cc, &n_pages) != PcoSuccess ||
+      n_pages == 0 || n_pages > 8) {
+    printf("Unexpected page count\n");
+    goto cleanup;
+  }
+  for (unsigned int i = 0; i < n_pages; i++) {
+    if (pco_wrapped_chunk_compressor_page_n(cc, i, &page_ns[i]) != PcoSuccess) {
+      printf("Error getting page n\n");
+      goto cleanup;
+    }
+    if (pco_wrapped_chunk_compressor_write_page(cc, i, &pages[i]) != PcoSuccess) {
+      printf("Error writing page\n");
+      goto cleanup;
+    }
+  }
+  printf("Compressed %d longs into %u pages\n", N, n_pages);
+
+  unsigned int n_bytes_read = 0;
+  if (pco_wrapped_file_decompressor_new(header.ptr, header.len, &fd, &n_bytes_read) !=
+      PcoSuccess) {
+    printf("Error creating file decompressor\n");
+    goto cleanup;
+  }
+  if (pco_wrapped_file_decompressor_chunk_decompressor(
+        fd, chunk_meta.ptr, chunk_meta.len, PCO_TYPE_I64, &cd, &n_bytes_read) != PcoSuccess) {
+    printf("Error creating chunk decompressor\n");
+    goto cleanup;
+  }
+
+  long output[N];
+  unsigned int n_decompressed = 0;
+  for (unsigned int i = 0; i < n_pages; i++) {
+    struct PcoProgress progress;
+    if (pco_wrapped_chunk_decompressor_decompress_page(
+          cd, pages[i].ptr, pages[i].len, page_ns[i], &output[n_decompressed], page_ns[i],
+          &progress, &n_bytes_read) != PcoSuccess) {
+      printf("Error decompressing page\n");
+      goto cleanup;
+    }
+    if (progress.n_processed != page_ns[i] || !progress.finished) {
+      printf("Unexpected page progress\n");
+      goto cleanup;
+    }
+    n_decompressed += progress.n_processed;
+  }
+  if (n_decompressed != N) {
+    printf("Decompressed count does not match!!!\n");
+    goto cleanup;
+  }
+  for (int i = 0; i < N; i++) {
+    if (input[i] != output[i]) {
+      printf("Values do not match!!!\n");
+      goto cleanup;
+    }
+  }
+  printf("Values match\n");
+
+  // the same values split into a fleet of small arrays sharing one chunk
+  // metadata: one (header, chunk meta) blob plus a metadata-less page per array
+  struct PcoArray arrays[8];
+  for (int a = 0; a < 8; a++) {
+    arrays[a].nums = &input[a * (N / 8)];
+    arrays[a].len = N / 8;
+    arrays[a].dtype = PCO_TYPE_I64;
+  }
+  struct PcoChunkConfig shared_config;
+  pco_default_chunk_config(&shared_config);
+  struct PcoFfiVec shared_meta;
+  struct PcoFfiVec shared_pages[8];
+  memset(&shared_meta, 0, sizeof(shared_meta));
+  memset(shared_pages, 0, sizeof(shared_pages));
+  if (pco_shared_compress(arrays, 8, &shared_config, &shared_meta, shared_pages) != PcoSuccess) {
+    printf("Error compressing with shared metadata\n");
+    goto cleanup;
+  }
+  struct PcoWrappedCd *shared_cd = NULL;
+  int shared_ok =
+    pco_shared_decompressor_new(shared_meta.ptr, shared_meta.len, PCO_TYPE_I64, &shared_cd) ==
+    PcoSuccess;
+  unsigned int shared_bytes = shared_meta.len;
+  for (int a = 0; shared_ok && a < 8; a++) {
+    long page_out[N / 8];
+    struct PcoProgress progress;
+    shared_ok = pco_wrapped_chunk_decompressor_decompress_page(
+                  shared_cd, shared_pages[a].ptr, shared_pages[a].len, N / 8, page_out, N / 8,
+                  &progress, &n_bytes_read) == PcoSuccess &&
+                progress.finished;
+    for (int i = 0; shared_ok && i < N / 8; i++) {
+      shared_ok = page_out[i] == input[a * (N / 8) + i];
+    }
+  }
+  for (int a = 0; a < 8; a++) {
+    shared_bytes += shared_pages[a].len;
+    if (shared_pages[a].ptr != NULL) {
+      pco_free_pcovec(&shared_pages[a]);
+    }
+  }
+  pco_free_pcovec(&shared_meta);
+  if (shared_cd != NULL) {
+    pco_wrapped_chunk_decompressor_free(shared_cd);
+  }
+  if (!shared_ok) {
+    printf("Shared-meta values do not match!!!\n");
+    goto cleanup;
+  }
+  printf("Shared-meta fleet: %u bytes across 8 arrays\n", shared_bytes);
+  retcode = 0;
+
+cleanup:
+  for (unsigned int i = 0; i < n_pages; i++) {
+    if (pages[i].ptr != NULL) {
+      pco_free_pcovec(&pages[i]);
+    }
+  }
+  if (chunk_meta.ptr != NULL) {
+    pco_free_pcovec(&chunk_meta);
+  }
+  if (header.ptr != NULL) {
+    pco_free_pcovec(&header);
+  }
+  if (cd != NULL) {
+    pco_wrapped_chunk_decompressor_free(cd);
+  }
+  if (fd != NULL) {
+    pco_wrapped_file_decompressor_free(fd);
+  }
+  if (cc != NULL) {
+    pco_wrapped_chunk_compressor_free(cc);
+  }
+  if (fc != NULL) {
+    pco_wrapped_file_compressor_free(fc);
+  }
+  return retcode;
+}
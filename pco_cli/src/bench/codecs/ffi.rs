@@ -0,0 +1,81 @@
+use std::os::raw::{c_uint, c_void};
+use std::ptr;
+
+use clap::Parser;
+
+use cpcodec::{pco_free_pcovec, pco_simple_decompress, pco_simpler_compress, PcoError, PcoFfiVec};
+
+use crate::bench::codecs::CodecInternal;
+use crate::dtypes::PcoNumberLike;
+
+/// Drives the C bindings in the cpcodec dylib with the same datasets as the
+/// native pco codec, so e.g. `bench pco,pco_ffi` quantifies the FFI overhead:
+/// the dynamic call, the runtime dtype dispatch, and the FFI-owned
+/// allocations. Copying the result back out of the FFI vector is included,
+/// matching a C caller that needs to own its buffer.
+#[derive(Clone, Debug, Parser)]
+pub struct FfiConfig {
+  #[arg(long, default_value = "8")]
+  level: usize,
+}
+
+fn empty_ffi_vec() -> PcoFfiVec {
+  PcoFfiVec {
+    ptr: ptr::null(),
+    len: 0,
+    raw_box: ptr::null(),
+  }
+}
+
+impl CodecInternal for FfiConfig {
+  fn name(&self) -> &'static str {
+    "pco_ffi"
+  }
+
+  fn get_confs(&self) -> Vec<(&'static str, String)> {
+    vec![("level", self.level.to_string())]
+  }
+
+  fn compress<T: PcoNumberLike>(&self, nums: &[T]) -> Vec<u8> {
+    let mut ffi_vec = empty_ffi_vec();
+    unsafe {
+      let code = pco_simpler_compress(
+        nums.as_ptr() as *const c_void,
+        nums.len() as c_uint,
+        T::DTYPE_BYTE,
+        self.level as c_uint,
+        &mut ffi_vec,
+      );
+      assert!(
+        matches!(code, PcoError::PcoSuccess),
+        "pco_simpler_compress failed"
+      );
+      let res = std::slice::from_raw_parts(
+        ffi_vec.ptr as *const u8,
+        ffi_vec.len as usize,
+      )
+      .to_vec();
+      pco_free_pcovec(&mut ffi_vec);
+      res
+    }
+  }
+
+  fn decompress<T: PcoNumberLike>(&self, compressed: &[u8]) -> Vec<T> {
+    let mut ffi_vec = empty_ffi_vec();
+    unsafe {
+      let code = pco_simple_decompress(
+        compressed.as_ptr() as *const c_void,
+        compressed.len() as c_uint,
+        T::DTYPE_BYTE,
+        &mut ffi_vec,
+      );
+      assert!(
+        matches!(code, PcoError::PcoSuccess),
+        "pco_simple_decompress failed"
+      );
+      let res = std::slice::from_raw_parts(ffi_vec.ptr as *const T, ffi_vec.len as usize).to_vec();
+      pco_free_pcovec(&mut ffi_vec);
+      res
+    }
+  }
+}
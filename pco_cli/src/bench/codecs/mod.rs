@@ -13,6 +13,8 @@ use ::pco::with_core_dtypes;
 
 #[cfg(feature = "full_bench")]
 use crate::bench::codecs::blosc::BloscConfig;
+#[cfg(feature = "ffi_bench")]
+use crate::bench::codecs::ffi::FfiConfig;
 use crate::bench::codecs::parquet::ParquetConfig;
 #[cfg(feature = "full_bench")]
 use crate::bench::codecs::qco::QcoConfig;
@@ -30,6 +32,8 @@ use crate::num_vec::NumVec;
 
 #[cfg(feature = "full_bench")]
 mod blosc;
+#[cfg(feature = "ffi_bench")]
+mod ffi;
 mod parquet;
 mod pco;
 #[cfg(feature = "full_bench")]
@@ -234,6 +238,8 @@ impl FromStr for CodecConfig {
       "blosc" => BloscConfig::from_kv_args(&clap_kv_args),
       "parquet" => ParquetConfig::from_kv_args(&clap_kv_args),
       "pco" | "pcodec" => ChunkConfigOpt::from_kv_args(&clap_kv_args),
+      #[cfg(feature = "ffi_bench")]
+      "pco_ffi" | "cpcodec" => FfiConfig::from_kv_args(&clap_kv_args),
       #[cfg(feature = "full_bench")]
       "qco" | "q_compress" => QcoConfig::from_kv_args(&clap_kv_args),
       "snap" | "snappy" => SnappyConfig::from_kv_args(&clap_kv_args),
@@ -244,7 +250,7 @@ impl FromStr for CodecConfig {
       "zstd" | "zstandard" => ZstdConfig::from_kv_args(&clap_kv_args),
       _ => {
         return Err(anyhow!(
-          "Unknown codec: {}. Perhaps rebuild with the full_bench feature?",
+          "Unknown codec: {}. Perhaps rebuild with the full_bench or ffi_bench feature?",
           name
         ))
       }